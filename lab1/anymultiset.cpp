@@ -0,0 +1,109 @@
+#include "anymultiset.h"
+
+AnyMultiset::Variant AnyMultiset::makeFor(const Universe& u) {
+    uint64_t maxMult = u.getMaxMultiplicity();
+    if (maxMult <= UINT8_MAX) return BasicMultiset<uint8_t>(u);
+    if (maxMult <= UINT16_MAX) return BasicMultiset<uint16_t>(u);
+    if (maxMult <= UINT32_MAX) return BasicMultiset<uint32_t>(u);
+    return BasicMultiset<uint64_t>(u);
+}
+
+AnyMultiset::AnyMultiset(const Universe& u) : value(makeFor(u)) {}
+
+template<typename Op>
+AnyMultiset AnyMultiset::combine(const AnyMultiset& other, Op op) const {
+    return std::visit([&](const auto& a) {
+        using M = std::decay_t<decltype(a)>;
+        const M* b = std::get_if<M>(&other.value);
+        if (!b) {
+            throw std::invalid_argument("Мультимножества построены над разными универсумами");
+        }
+        return AnyMultiset(op(a, *b));
+    }, value);
+}
+
+const Universe& AnyMultiset::getUniverse() const {
+    return visit([](const auto& ms) -> const Universe& { return ms; });
+}
+
+int AnyMultiset::getDepth() const {
+    return getUniverse().getDepth();
+}
+
+uint64_t AnyMultiset::getMaxMultiplicity() const {
+    return getUniverse().getMaxMultiplicity();
+}
+
+bool AnyMultiset::isSparse() const {
+    return getUniverse().isSparse();
+}
+
+int AnyMultiset::counterBits() const {
+    return visit([](const auto& ms) {
+        return static_cast<int>(8 * sizeof(ms.getCounts()[0]));
+    });
+}
+
+void AnyMultiset::fillManual(int size) {
+    visit([size](auto& ms) { ms.fillManual(size); });
+}
+
+void AnyMultiset::fillRandom() {
+    visit([](auto& ms) { ms.fillRandom(); });
+}
+
+AnyMultiset AnyMultiset::unionWith(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.unionWith(b); });
+}
+
+AnyMultiset AnyMultiset::intersectionWith(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.intersectionWith(b); });
+}
+
+AnyMultiset AnyMultiset::differenceWith(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.differenceWith(b); });
+}
+
+AnyMultiset AnyMultiset::symmetricDifferenceWith(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.symmetricDifferenceWith(b); });
+}
+
+AnyMultiset AnyMultiset::complement() const {
+    return visit([](const auto& ms) { return AnyMultiset(ms.complement()); });
+}
+
+AnyMultiset AnyMultiset::arithmeticSum(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.arithmeticSum(b); });
+}
+
+AnyMultiset AnyMultiset::arithmeticDifference(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.arithmeticDifference(b); });
+}
+
+AnyMultiset AnyMultiset::arithmeticProduct(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.arithmeticProduct(b); });
+}
+
+AnyMultiset AnyMultiset::arithmeticDivision(const AnyMultiset& other) const {
+    return combine(other, [](const auto& a, const auto& b) { return a.arithmeticDivision(b); });
+}
+
+int AnyMultiset::countNonZero() const {
+    return visit([](const auto& ms) { return ms.countNonZero(); });
+}
+
+void AnyMultiset::printTable() const {
+    visit([](const auto& ms) { ms.printTable(); });
+}
+
+bool AnyMultiset::isEmpty() const {
+    return visit([](const auto& ms) { return ms.isEmpty(); });
+}
+
+bool AnyMultiset::operator==(const AnyMultiset& other) const {
+    return value == other.value;
+}
+
+bool AnyMultiset::operator!=(const AnyMultiset& other) const {
+    return !(*this == other);
+}
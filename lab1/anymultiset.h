@@ -0,0 +1,63 @@
+#pragma once
+#include <variant>
+#include "multiset.h"
+
+// Мультимножество с самым узким типом счётчика, вмещающим максимальную
+// кратность универсума (uint8_t до 255, uint16_t до 65535 и т.д.).
+// Все мультимножества одного универсума получают один и тот же тип,
+// поэтому операции между ними не требуют преобразований.
+class AnyMultiset {
+private:
+    using Variant = std::variant<BasicMultiset<uint8_t>, BasicMultiset<uint16_t>,
+                                 BasicMultiset<uint32_t>, BasicMultiset<uint64_t>>;
+
+    Variant value;
+
+    template<typename Count>
+    explicit AnyMultiset(BasicMultiset<Count> ms) : value(std::move(ms)) {}
+
+    static Variant makeFor(const Universe& u);
+
+    template<typename Op>
+    AnyMultiset combine(const AnyMultiset& other, Op op) const;
+
+public:
+    explicit AnyMultiset(const Universe& u);
+
+    // вызов func с мультимножеством фактического типа счётчика
+    template<typename Func>
+    decltype(auto) visit(Func&& func) {
+        return std::visit(std::forward<Func>(func), value);
+    }
+
+    template<typename Func>
+    decltype(auto) visit(Func&& func) const {
+        return std::visit(std::forward<Func>(func), value);
+    }
+
+    const Universe& getUniverse() const;
+    int getDepth() const;
+    uint64_t getMaxMultiplicity() const;
+    bool isSparse() const;
+    int counterBits() const;
+
+    void fillManual(int size);
+    void fillRandom();
+
+    AnyMultiset unionWith(const AnyMultiset& other) const;
+    AnyMultiset intersectionWith(const AnyMultiset& other) const;
+    AnyMultiset differenceWith(const AnyMultiset& other) const;
+    AnyMultiset symmetricDifferenceWith(const AnyMultiset& other) const;
+    AnyMultiset complement() const;
+    AnyMultiset arithmeticSum(const AnyMultiset& other) const;
+    AnyMultiset arithmeticDifference(const AnyMultiset& other) const;
+    AnyMultiset arithmeticProduct(const AnyMultiset& other) const;
+    AnyMultiset arithmeticDivision(const AnyMultiset& other) const;
+
+    int countNonZero() const;
+    void printTable() const;
+
+    bool isEmpty() const;
+    bool operator==(const AnyMultiset& other) const;
+    bool operator!=(const AnyMultiset& other) const;
+};
@@ -0,0 +1,454 @@
+#include "bulkio.h"
+#include <cstring>
+#include <memory>
+
+namespace {
+
+using FileHandle = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+FileHandle openFile(const std::string& path, const char* mode) {
+    FileHandle file(std::fopen(path.c_str(), mode), &std::fclose);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть файл: " + path);
+    }
+    return file;
+}
+
+template<typename Count>
+struct ImportRow {
+    uint64_t code;
+    uint64_t row;
+    Count count;
+};
+
+uint64_t readLE64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+void writeLE64(unsigned char* p, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// заголовок, который пишет exportCSV
+const char CSV_HEADER[] = "code,multiplicity";
+
+// Строка [begin, end) - заголовок CSV_HEADER (пробелы по краям допускаются)
+bool isCSVHeader(const char* begin, const char* end) {
+    while (begin < end && isBlank(*begin)) ++begin;
+    while (end > begin && isBlank(end[-1])) --end;
+    size_t length = sizeof(CSV_HEADER) - 1;
+    return static_cast<size_t>(end - begin) == length && std::memcmp(begin, CSV_HEADER, length) == 0;
+}
+
+// Разбор одной строки CSV [p, end) без выделения памяти.
+// Возвращает false и причину отказа, если строка некорректна.
+template<typename Count>
+bool parseCSVLine(const char* p, const char* end, int depth, Count maxCount,
+                  uint64_t& code, Count& count, ImportRejectReason& reason) {
+    while (p < end && isBlank(*p)) ++p;
+
+    const char* codeStart = p;
+    uint64_t value = 0;
+    while (p < end && (*p == '0' || *p == '1') && p - codeStart <= depth) {
+        value = (value << 1) | static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+
+    if (p - codeStart != depth || (p < end && *p != ',' && !isBlank(*p))) {
+        reason = ImportRejectReason::BadCode;
+        return false;
+    }
+
+    while (p < end && isBlank(*p)) ++p;
+    if (p == end || *p != ',') {
+        reason = ImportRejectReason::BadFormat;
+        return false;
+    }
+    ++p;
+    while (p < end && isBlank(*p)) ++p;
+
+    const char* numberStart = p;
+    uint64_t mult = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (__builtin_mul_overflow(mult, 10, &mult)
+            || __builtin_add_overflow(mult, static_cast<uint64_t>(*p - '0'), &mult)
+            || mult > maxCount) {
+            reason = ImportRejectReason::BadMultiplicity;
+            return false;
+        }
+        ++p;
+    }
+
+    if (p == numberStart) {
+        reason = ImportRejectReason::BadMultiplicity;
+        return false;
+    }
+
+    while (p < end && isBlank(*p)) ++p;
+    if (p != end) {
+        reason = ImportRejectReason::BadFormat;
+        return false;
+    }
+
+    code = value;
+    count = static_cast<Count>(mult);
+    return true;
+}
+
+// Сортировка по коду (при равенстве - по номеру строки), отбраковка повторов
+// и заполнение мультимножества.
+template<typename Count>
+void finishImport(BasicMultiset<Count>& ms, std::vector<ImportRow<Count>>& rows, ImportReport& report) {
+    auto byCode = [](const ImportRow<Count>& a, const ImportRow<Count>& b) {
+        return a.code != b.code ? a.code < b.code : a.row < b.row;
+    };
+
+    if (!std::is_sorted(rows.begin(), rows.end(), byCode)) {
+        std::sort(rows.begin(), rows.end(), byCode);
+    }
+
+    std::vector<uint64_t> codes;
+    std::vector<Count> counts;
+    codes.reserve(rows.size());
+    counts.reserve(rows.size());
+
+    // повторы находятся только после сортировки, а report.samples уже
+    // заполнен при разборе; номера повторов собираются отдельно и
+    // сливаются с образцами по номеру строки, чтобы в отчёт попали именно
+    // первые отклонённые строки
+    std::vector<uint64_t> duplicates;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (i > 0 && rows[i].code == rows[i - 1].code) {
+            ++report.rejected;
+            ++report.byReason[static_cast<int>(ImportRejectReason::Duplicate)];
+            if (duplicates.size() < static_cast<size_t>(IMPORT_REPORTED_ROWS)
+                || rows[i].row < duplicates.back()) {
+                if (duplicates.size() == static_cast<size_t>(IMPORT_REPORTED_ROWS)) {
+                    duplicates.pop_back();
+                }
+                duplicates.insert(std::upper_bound(duplicates.begin(), duplicates.end(), rows[i].row),
+                                  rows[i].row);
+            }
+            continue;
+        }
+
+        ++report.accepted;
+        if (rows[i].count > 0) {
+            codes.push_back(rows[i].code);
+            counts.push_back(rows[i].count);
+        }
+    }
+
+    std::vector<std::pair<uint64_t, ImportRejectReason>> samples;
+    samples.reserve(duplicates.size());
+    for (uint64_t row : duplicates) {
+        samples.emplace_back(row, ImportRejectReason::Duplicate);
+    }
+    std::sort(report.samples.begin(), report.samples.end());
+    std::vector<std::pair<uint64_t, ImportRejectReason>> merged(report.samples.size() + samples.size());
+    std::merge(report.samples.begin(), report.samples.end(), samples.begin(), samples.end(), merged.begin());
+    if (merged.size() > static_cast<size_t>(IMPORT_REPORTED_ROWS)) {
+        merged.resize(IMPORT_REPORTED_ROWS);
+    }
+    report.samples = std::move(merged);
+    ms.fillSorted(std::move(codes), std::move(counts));
+}
+
+}
+
+void ImportReport::reject(uint64_t row, ImportRejectReason reason) {
+    ++rejected;
+    ++byReason[static_cast<int>(reason)];
+    if (samples.size() < static_cast<size_t>(IMPORT_REPORTED_ROWS)) {
+        samples.emplace_back(row, reason);
+    }
+}
+
+const char* rejectReasonName(ImportRejectReason reason) {
+    switch (reason) {
+        case ImportRejectReason::BadFormat: return "некорректный формат строки";
+        case ImportRejectReason::BadCode: return "некорректный код Грея";
+        case ImportRejectReason::OutOfUniverse: return "элемент вне универсума";
+        case ImportRejectReason::BadMultiplicity: return "некорректная кратность";
+        case ImportRejectReason::Duplicate: return "повторный элемент";
+    }
+    return "неизвестная причина";
+}
+
+void ImportReport::print() const {
+    std::cout << "\n  Прочитано записей: " << rowsRead << " (" << bytesRead << " байт)\n";
+    std::cout << "  Принято: " << accepted << "\n";
+    std::cout << "  Отклонено: " << rejected << "\n";
+
+    if (rejected == 0) {
+        std::cout << "\n";
+        return;
+    }
+
+    for (int i = 0; i < IMPORT_REJECT_REASONS; ++i) {
+        if (byReason[i] > 0) {
+            std::cout << "    - " << rejectReasonName(static_cast<ImportRejectReason>(i))
+                      << ": " << byReason[i] << "\n";
+        }
+    }
+
+    std::cout << "\n  Первые отклонённые записи:\n";
+    for (const auto& [row, reason] : samples) {
+        std::cout << "    " << std::setw(10) << row << ": " << rejectReasonName(reason) << "\n";
+    }
+    std::cout << "\n";
+}
+
+template<typename Count>
+ImportReport importCSV(BasicMultiset<Count>& ms, const std::string& path) {
+    FileHandle file = openFile(path, "rb");
+
+    ImportReport report;
+    std::vector<ImportRow<Count>> rows;
+    std::vector<char> buffer(IMPORT_BUFFER_SIZE);
+
+    int depth = ms.getDepth();
+    Count maxCount = static_cast<Count>(ms.getMaxMultiplicity());
+    bool universeEmpty = ms.size() == 0;
+
+    uint64_t lineNo = 0;
+    bool skippingLongLine = false;
+    size_t filled = 0;
+
+    auto processLine = [&](const char* begin, const char* end) {
+        ++lineNo;
+
+        const char* first = begin;
+        while (first < end && isBlank(*first)) ++first;
+        if (first == end || *first == '#') return;
+        // пропускается только настоящий заголовок, иначе некорректная первая
+        // строка данных исчезла бы без отметки в отчёте
+        if (lineNo == 1 && isCSVHeader(first, end)) return;
+
+        ++report.rowsRead;
+
+        if (universeEmpty) {
+            report.reject(lineNo, ImportRejectReason::OutOfUniverse);
+            return;
+        }
+
+        uint64_t code;
+        Count count;
+        ImportRejectReason reason;
+        if (!parseCSVLine(begin, end, depth, maxCount, code, count, reason)) {
+            report.reject(lineNo, reason);
+            return;
+        }
+
+        rows.push_back({code, lineNo, count});
+    };
+
+    while (true) {
+        size_t got = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file.get());
+        if (std::ferror(file.get())) {
+            throw std::runtime_error("Ошибка чтения файла: " + path);
+        }
+        report.bytesRead += got;
+        filled += got;
+
+        const char* p = buffer.data();
+        const char* end = p + filled;
+
+        while (const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p))) {
+            if (skippingLongLine) {
+                skippingLongLine = false;
+            } else {
+                processLine(p, newline);
+            }
+            p = newline + 1;
+        }
+
+        size_t rest = end - p;
+
+        if (got == 0) {
+            if (rest > 0 && !skippingLongLine) {
+                processLine(p, end);
+            }
+            break;
+        }
+
+        if (rest == buffer.size()) {
+            // строка длиннее буфера заведомо некорректна - пропускаем её до конца
+            if (!skippingLongLine) {
+                ++lineNo;
+                ++report.rowsRead;
+                report.reject(lineNo, ImportRejectReason::BadFormat);
+                skippingLongLine = true;
+            }
+            filled = 0;
+            continue;
+        }
+
+        std::memmove(buffer.data(), p, rest);
+        filled = rest;
+    }
+
+    finishImport(ms, rows, report);
+    return report;
+}
+
+template<typename Count>
+ImportReport importBinary(BasicMultiset<Count>& ms, const std::string& path) {
+    const size_t recordSize = 16;
+
+    FileHandle file = openFile(path, "rb");
+
+    ImportReport report;
+    std::vector<ImportRow<Count>> rows;
+    std::vector<unsigned char> buffer(IMPORT_BUFFER_SIZE);
+
+    uint64_t universeSize = ms.size();
+    uint64_t maxMult = ms.getMaxMultiplicity();
+
+    uint64_t record = 0;
+    size_t filled = 0;
+
+    while (true) {
+        size_t got = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file.get());
+        if (std::ferror(file.get())) {
+            throw std::runtime_error("Ошибка чтения файла: " + path);
+        }
+        report.bytesRead += got;
+        filled += got;
+
+        size_t complete = filled / recordSize * recordSize;
+        for (size_t offset = 0; offset < complete; offset += recordSize) {
+            ++record;
+            ++report.rowsRead;
+
+            uint64_t rank = readLE64(buffer.data() + offset);
+            uint64_t count = readLE64(buffer.data() + offset + 8);
+
+            if (rank >= universeSize) {
+                report.reject(record, ImportRejectReason::OutOfUniverse);
+            } else if (count > maxMult) {
+                report.reject(record, ImportRejectReason::BadMultiplicity);
+            } else {
+                rows.push_back({Universe::grayCode(rank), record, static_cast<Count>(count)});
+            }
+        }
+
+        size_t rest = filled - complete;
+
+        if (got == 0) {
+            if (rest > 0) {
+                ++record;
+                ++report.rowsRead;
+                report.reject(record, ImportRejectReason::BadFormat);
+            }
+            break;
+        }
+
+        std::memmove(buffer.data(), buffer.data() + complete, rest);
+        filled = rest;
+    }
+
+    finishImport(ms, rows, report);
+    return report;
+}
+
+template<typename Count>
+void exportCSV(const BasicMultiset<Count>& ms, const std::string& path) {
+    FileHandle file = openFile(path, "wb");
+
+    std::vector<char> buffer(IMPORT_BUFFER_SIZE);
+    size_t used = 0;
+
+    auto flush = [&]() {
+        if (std::fwrite(buffer.data(), 1, used, file.get()) != used) {
+            throw std::runtime_error("Ошибка записи файла: " + path);
+        }
+        used = 0;
+    };
+
+    std::memcpy(buffer.data(), CSV_HEADER, sizeof(CSV_HEADER) - 1);
+    used = sizeof(CSV_HEADER) - 1;
+    buffer[used++] = '\n';
+
+    int depth = ms.getDepth();
+    const auto& codes = ms.getCodes();
+    const auto& counts = ms.getCounts();
+
+    // код, запятая, до 20 цифр кратности и перевод строки
+    size_t maxRow = static_cast<size_t>(depth) + 22;
+
+    for (size_t i = 0; i < codes.size(); ++i) {
+        if (buffer.size() - used < maxRow) flush();
+
+        char* out = buffer.data() + used;
+        for (int j = 0; j < depth; ++j) {
+            *out++ = static_cast<char>('0' + ((codes[i] >> (depth - 1 - j)) & 1));
+        }
+        *out++ = ',';
+
+        char digits[20];
+        int len = 0;
+        uint64_t value = counts[i];
+        do {
+            digits[len++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (len > 0) *out++ = digits[--len];
+        *out++ = '\n';
+
+        used = out - buffer.data();
+    }
+
+    flush();
+}
+
+template<typename Count>
+void exportBinary(const BasicMultiset<Count>& ms, const std::string& path) {
+    const size_t recordSize = 16;
+
+    FileHandle file = openFile(path, "wb");
+
+    std::vector<unsigned char> buffer(IMPORT_BUFFER_SIZE);
+    size_t used = 0;
+
+    auto flush = [&]() {
+        if (std::fwrite(buffer.data(), 1, used, file.get()) != used) {
+            throw std::runtime_error("Ошибка записи файла: " + path);
+        }
+        used = 0;
+    };
+
+    const auto& codes = ms.getCodes();
+    const auto& counts = ms.getCounts();
+
+    for (size_t i = 0; i < codes.size(); ++i) {
+        if (buffer.size() - used < recordSize) flush();
+
+        writeLE64(buffer.data() + used, Universe::grayRank(codes[i]));
+        writeLE64(buffer.data() + used + 8, counts[i]);
+        used += recordSize;
+    }
+
+    flush();
+}
+
+#define INSTANTIATE_BULKIO(Count)                                                   \
+    template ImportReport importCSV<Count>(BasicMultiset<Count>&, const std::string&);    \
+    template ImportReport importBinary<Count>(BasicMultiset<Count>&, const std::string&); \
+    template void exportCSV<Count>(const BasicMultiset<Count>&, const std::string&);      \
+    template void exportBinary<Count>(const BasicMultiset<Count>&, const std::string&);
+
+INSTANTIATE_BULKIO(uint8_t)
+INSTANTIATE_BULKIO(uint16_t)
+INSTANTIATE_BULKIO(uint32_t)
+INSTANTIATE_BULKIO(uint64_t)
@@ -0,0 +1,51 @@
+#pragma once
+#include "multiset.h"
+#include <cstdio>
+
+// Пакетный импорт/экспорт мультимножеств.
+//
+// CSV: строки вида "код,кратность", где код - строка кода Грея длины depth;
+// первая строка может быть заголовком "code,multiplicity" (его пишет
+// exportCSV), строки с '#' - комментарии.
+// Бинарный формат: записи по 16 байт - ранг в последовательности Грея (uint64)
+// и кратность (uint64), порядок байт little-endian.
+
+enum class ImportRejectReason {
+    BadFormat,
+    BadCode,
+    OutOfUniverse,
+    BadMultiplicity,
+    Duplicate,
+};
+
+static const int IMPORT_REJECT_REASONS = 5;
+static const int IMPORT_REPORTED_ROWS = 10;
+static const size_t IMPORT_BUFFER_SIZE = 1 << 20;
+
+struct ImportReport {
+    uint64_t rowsRead = 0;
+    uint64_t accepted = 0;
+    uint64_t rejected = 0;
+    uint64_t bytesRead = 0;
+    uint64_t byReason[IMPORT_REJECT_REASONS] = {};
+
+    // первые отклонённые строки: номер строки (записи) и причина
+    std::vector<std::pair<uint64_t, ImportRejectReason>> samples;
+
+    void reject(uint64_t row, ImportRejectReason reason);
+    void print() const;
+};
+
+const char* rejectReasonName(ImportRejectReason reason);
+
+template<typename Count>
+ImportReport importCSV(BasicMultiset<Count>& ms, const std::string& path);
+
+template<typename Count>
+ImportReport importBinary(BasicMultiset<Count>& ms, const std::string& path);
+
+template<typename Count>
+void exportCSV(const BasicMultiset<Count>& ms, const std::string& path);
+
+template<typename Count>
+void exportBinary(const BasicMultiset<Count>& ms, const std::string& path);
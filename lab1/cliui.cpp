@@ -1,5 +1,9 @@
 #include "cliui.h"
 #include "universe.h"
+#include "bulkio.h"
+#include "fixedmultiset.h"
+#include <chrono>
+#include <sstream>
 #include <string>
 
 
@@ -34,7 +38,7 @@ std::string CLIUI::inputMultisetName(const std::string& prompt) {
     return name;
 }
 
-Multiset* CLIUI::getMultiset(const std::string& name) {
+AnyMultiset* CLIUI::getMultiset(const std::string& name) {
     auto it = multisets.find(name);
     if (it == multisets.end()) {
         return nullptr;
@@ -74,8 +78,9 @@ void CLIUI::showMainMenu() {
     std::cout << "  [5] Арифметические операции\n";
     std::cout << "  [6] Сравнить мультимножества\n";
     std::cout << "  [7] Показать все операции (сводка)\n";
-    std::cout << "  [8] " << (showTimings ? "Скрыть" : "Показать")
-                  << " время выполнения операций\n";
+    std::cout << "  [8] Измерение производительности (замеры "
+                  << (showTimings ? "показываются" : "скрыты") << ")\n";
+    std::cout << "  [9] Экспорт мультимножества в файл\n";
     std::cout << "  [0] Выход\n";
 
     printSeparator();
@@ -83,6 +88,10 @@ void CLIUI::showMainMenu() {
 
     int choice;
     if (!(std::cin >> choice)) {
+        if (std::cin.eof()) {
+            std::cout << "\n До свидания!\n";
+            exit(0);
+        }
         std::cin.clear();
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         std::cout << "\n Ошибка ввода!\n";
@@ -98,11 +107,8 @@ void CLIUI::showMainMenu() {
         case 5: arithmeticOperationsMenu(); break;
         case 6: compareMultisetsMenu(); break;
         case 7: showAllOperations(); break;
-        case 8:
-            showTimings = !showTimings;
-            std::cout << "\n  Отображение времени: " << (showTimings ? "включено" : "выключено") << "\n";
-            pause();
-            break;
+        case 8: timingMenu(); break;
+        case 9: exportMultisetMenu(); break;
         case 0:
             std::cout << "\n До свидания!\n";
             exit(0);
@@ -129,10 +135,12 @@ void CLIUI::createUniverseMenu() {
         isResetUniverse = true;
     }
 
-    int depth, maxMult;
+    int depth;
+    long long maxMult;
 
-    std::cout << "Введите разрядность кода Грея (рекомендуется до " + std::to_string(RECOMMENDED_MAX_DEPTH) + "): ";
-    if (!(std::cin >> depth) || depth < 0) {
+    std::cout << "Введите разрядность кода Грея (рекомендуется до " + std::to_string(RECOMMENDED_MAX_DEPTH)
+                 + ", максимум " + std::to_string(MAX_DEPTH) + "): ";
+    if (!(std::cin >> depth) || depth < 0 || depth > MAX_DEPTH) {
         std::cout << "\n Некорректная разрядность!\n";
         pause();
         return;
@@ -156,7 +164,7 @@ void CLIUI::createUniverseMenu() {
             std::cout << " Старый универсум удалён\n\n";
         }
 
-        measureTimeVoid([&]() {
+        measureTimeVoid("Создание универсума", 0, [&]() {
             universe = std::make_unique<Universe>(depth, maxMult);
         });
 
@@ -186,7 +194,7 @@ void CLIUI::createMultisetMenu() {
         return;
     }
 
-    auto ms = std::make_unique<Multiset>(*universe);
+    auto ms = std::make_unique<AnyMultiset>(*universe);
 
     if (ms->getDepth() == 0 || ms->getMaxMultiplicity() == 0) {
         std::cout << "  Создано пустое мультимножество\n";
@@ -198,6 +206,7 @@ void CLIUI::createMultisetMenu() {
     std::cout << "\nВыберите способ заполнения:\n";
     std::cout << "  [1] Вручную\n";
     std::cout << "  [2] Автоматически (случайно)\n";
+    std::cout << "  [3] Из файла (CSV или бинарный)\n";
     std::cout << "Ваш выбор: ";
 
     int choice;
@@ -213,9 +222,19 @@ void CLIUI::createMultisetMenu() {
             ms->fillManual(size);
 
         } else if (choice == 2) {
-            measureTimeVoid([&]() {
+            measureTimeVoid("Случайное заполнение", 0, [&]() {
                 ms->fillRandom();
             });
+        } else if (choice == 3) {
+            int format = inputFileFormat();
+            std::string path = inputFilePath("Путь к файлу: ");
+
+            ImportReport report = measureTime(format == 1 ? "Импорт CSV" : "Импорт бинарный", 0, [&]() {
+                return ms->visit([&](auto& typed) {
+                    return format == 1 ? importCSV(typed, path) : importBinary(typed, path);
+                });
+            });
+            report.print();
         } else {
             std::cout << " Неверный выбор!\n";
             pause();
@@ -224,6 +243,7 @@ void CLIUI::createMultisetMenu() {
 
         std::cout << "\n Мультимножество '" << name << "' создано:\n";
         ms->printTable();
+        std::cout << "  Счётчик кратности: " << ms->counterBits() << " бит\n";
 
         multisets[name] = std::move(ms);
         pause();
@@ -234,6 +254,73 @@ void CLIUI::createMultisetMenu() {
     }
 }
 
+int CLIUI::inputFileFormat() {
+    std::cout << "Формат файла:\n";
+    std::cout << "  [1] CSV (код,кратность)\n";
+    std::cout << "  [2] Бинарный (ранг и кратность, по 8 байт)\n";
+    std::cout << "Ваш выбор: ";
+
+    int format;
+    if (!(std::cin >> format) || (format != 1 && format != 2)) {
+        throw std::invalid_argument("Неверный формат файла");
+    }
+    return format;
+}
+
+std::string CLIUI::inputFilePath(const std::string& prompt) {
+    std::string path;
+    std::cout << prompt;
+    std::cin >> path;
+    return path;
+}
+
+void CLIUI::exportMultisetMenu() {
+    clearScreen();
+    printHeader("ЭКСПОРТ МУЛЬТИМНОЖЕСТВА");
+
+    if (multisets.empty()) {
+        std::cout << "  Мультимножества не созданы!\n";
+        pause();
+        return;
+    }
+
+    std::cout << "Доступные мультимножества: ";
+    for (const auto& [name, _] : multisets) {
+        std::cout << name << " ";
+    }
+    std::cout << "\n";
+
+    std::string name = inputMultisetName("\nМультимножество: ");
+    AnyMultiset* ms = getMultiset(name);
+
+    if (!ms) {
+        std::cout << " Мультимножество не найдено!\n";
+        pause();
+        return;
+    }
+
+    try {
+        int format = inputFileFormat();
+        std::string path = inputFilePath("Путь к файлу: ");
+
+        measureTimeVoid(format == 1 ? "Экспорт CSV" : "Экспорт бинарный", ms->countNonZero(), [&]() {
+            ms->visit([&](const auto& typed) {
+                if (format == 1) {
+                    exportCSV(typed, path);
+                } else {
+                    exportBinary(typed, path);
+                }
+            });
+        });
+
+        std::cout << "\n Экспортировано элементов: " << ms->countNonZero() << "\n";
+    } catch (const std::exception& e) {
+        std::cout << "\n Ошибка: " << e.what() << "\n";
+    }
+
+    pause();
+}
+
 void CLIUI::viewMultisetsMenu() {
     clearScreen();
     printHeader("ПРОСМОТР МУЛЬТИМНОЖЕСТВ");
@@ -278,11 +365,11 @@ void CLIUI::operationsMenu() {
     std::cin >> choice;
 
     switch (choice) {
-        case 1: performBinaryOperation("Объединение", &Multiset::unionWith); break;
-        case 2: performBinaryOperation("Пересечение", &Multiset::intersectionWith); break;
-        case 3: performBinaryOperation("Разность", &Multiset::differenceWith); break;
-        case 4: performBinaryOperation("Симметрическая разность", &Multiset::symmetricDifferenceWith); break;
-        case 5: performUnaryOperation("Дополнение", &Multiset::complement); break;
+        case 1: performBinaryOperation("Объединение", &AnyMultiset::unionWith); break;
+        case 2: performBinaryOperation("Пересечение", &AnyMultiset::intersectionWith); break;
+        case 3: performBinaryOperation("Разность", &AnyMultiset::differenceWith); break;
+        case 4: performBinaryOperation("Симметрическая разность", &AnyMultiset::symmetricDifferenceWith); break;
+        case 5: performUnaryOperation("Дополнение", &AnyMultiset::complement); break;
         case 0: return;
         default:
             std::cout << " Неверный выбор!\n";
@@ -312,10 +399,10 @@ void CLIUI::arithmeticOperationsMenu() {
     std::cin >> choice;
 
     switch (choice) {
-        case 1: performBinaryOperation("Арифметическая сумма", &Multiset::arithmeticSum); break;
-        case 2: performBinaryOperation("Арифметическая разность", &Multiset::arithmeticDifference); break;
-        case 3: performBinaryOperation("Арифметическое произведение", &Multiset::arithmeticProduct); break;
-        case 4: performBinaryOperation("Арифметическое деление", &Multiset::arithmeticDivision); break;
+        case 1: performBinaryOperation("Арифметическая сумма", &AnyMultiset::arithmeticSum); break;
+        case 2: performBinaryOperation("Арифметическая разность", &AnyMultiset::arithmeticDifference); break;
+        case 3: performBinaryOperation("Арифметическое произведение", &AnyMultiset::arithmeticProduct); break;
+        case 4: performBinaryOperation("Арифметическое деление", &AnyMultiset::arithmeticDivision); break;
         case 0: return;
         default:
             std::cout << " Неверный выбор!\n";
@@ -325,7 +412,7 @@ void CLIUI::arithmeticOperationsMenu() {
 
 void CLIUI::performBinaryOperation(
     const std::string& opName,
-    Multiset (Multiset::*operation)(const Multiset&) const
+    AnyMultiset (AnyMultiset::*operation)(const AnyMultiset&) const
 ) {
     if (multisets.size() < 2) {
         std::cout << "\n Нужно минимум два мультимножества!\n";
@@ -342,8 +429,8 @@ void CLIUI::performBinaryOperation(
     std::string nameA = inputMultisetName("\nПервое мультимножество (A): ");
     std::string nameB = inputMultisetName("Второе мультимножество (B): ");
 
-    Multiset* A = getMultiset(nameA);
-    Multiset* B = getMultiset(nameB);
+    AnyMultiset* A = getMultiset(nameA);
+    AnyMultiset* B = getMultiset(nameB);
 
     if (!A || !B) {
         std::cout << " Одно из мультимножеств не найдено!\n";
@@ -358,7 +445,7 @@ void CLIUI::performBinaryOperation(
     std::cout << "\nB = \n";
     B->printTable();
 
-    Multiset result = measureTime([&]() {
+    AnyMultiset result = measureTime(opName, A->countNonZero() + B->countNonZero(), [&]() {
         return (A->*operation)(*B);
     });
 
@@ -380,7 +467,7 @@ void CLIUI::performBinaryOperation(
                 return;
             }
         }
-        multisets[resultName] = std::make_unique<Multiset>(result);
+        multisets[resultName] = std::make_unique<AnyMultiset>(result);
         std::cout << " Результат сохранён как '" << resultName << "'\n";
     }
 
@@ -389,7 +476,7 @@ void CLIUI::performBinaryOperation(
 
 void CLIUI::performUnaryOperation(
     const std::string& opName,
-    Multiset (Multiset::*operation)() const
+    AnyMultiset (AnyMultiset::*operation)() const
 ) {
     std::cout << "\nДоступные мультимножества: ";
     for (const auto& [name, _] : multisets) {
@@ -398,7 +485,7 @@ void CLIUI::performUnaryOperation(
     std::cout << "\n";
 
     std::string nameA = inputMultisetName("\nМультимножество: ");
-    Multiset* A = getMultiset(nameA);
+    AnyMultiset* A = getMultiset(nameA);
 
     if (!A) {
         std::cout << " Мультимножество не найдено!\n";
@@ -411,9 +498,16 @@ void CLIUI::performUnaryOperation(
     std::cout << "A = ";
     A->printTable();
 
-    Multiset result = measureTime([&]() {
-        return (A->*operation)();
-    });
+    AnyMultiset result(*A);
+    try {
+        result = measureTime(opName, A->countNonZero(), [&]() {
+            return (A->*operation)();
+        });
+    } catch (const std::exception& e) {
+        std::cout << "\n Ошибка: " << e.what() << "\n";
+        pause();
+        return;
+    }
 
     std::cout << "\nРезультат:\n";
     result.printTable();
@@ -424,7 +518,7 @@ void CLIUI::performUnaryOperation(
 
     if (save == 'y' || save == 'Y') {
         std::string resultName = inputMultisetName("Имя мультимножества для результата: ");
-        multisets[resultName] = std::make_unique<Multiset>(result);
+        multisets[resultName] = std::make_unique<AnyMultiset>(result);
         std::cout << " Результат сохранён как '" << resultName << "'\n";
     }
 
@@ -450,8 +544,8 @@ void CLIUI::compareMultisetsMenu() {
     std::string nameA = inputMultisetName("\nПервое мультимножество: ");
     std::string nameB = inputMultisetName("Второе мультимножество: ");
 
-    Multiset* A = getMultiset(nameA);
-    Multiset* B = getMultiset(nameB);
+    AnyMultiset* A = getMultiset(nameA);
+    AnyMultiset* B = getMultiset(nameB);
 
     if (!A || !B) {
         std::cout << " Одно из мультимножеств не найдено!\n";
@@ -493,8 +587,8 @@ void CLIUI::showAllOperations() {
     std::string nameA = inputMultisetName("\nПервое мультимножество (A): ");
     std::string nameB = inputMultisetName("Второе мультимножество (B): ");
 
-    Multiset* A = getMultiset(nameA);
-    Multiset* B = getMultiset(nameB);
+    AnyMultiset* A = getMultiset(nameA);
+    AnyMultiset* B = getMultiset(nameB);
 
     if (!A || !B) {
         std::cout << " Одно из мультимножеств не найдено!\n";
@@ -510,83 +604,101 @@ void CLIUI::showAllOperations() {
     std::cout << "\nB = \n";
     B->printTable();
 
+    uint64_t inputs = A->countNonZero() + B->countNonZero();
+
     printSeparator();
     std::cout << "Операции над мультимножествами:\n";
     printSeparator();
 
     std::cout << "\n1. Объединение (A ∪ B):\n";
-    measureTime([&]{ return A->unionWith(*B); }).printTable();
+    measureTime("Объединение", inputs, [&] { return A->unionWith(*B); }).printTable();
 
     std::cout << "\n2. Пересечение (A ∩ B):\n";
-    measureTime([&] { return A->intersectionWith(*B); }).printTable();
+    measureTime("Пересечение", inputs, [&] { return A->intersectionWith(*B); }).printTable();
 
     std::cout << "\n3. Разность (A \\ B):\n";
-    measureTime([&] { return A->differenceWith(*B); }).printTable();
+    measureTime("Разность", inputs, [&] { return A->differenceWith(*B); }).printTable();
 
     std::cout << "\n4. Разность (B \\ A):\n";
-    measureTime([&] { return B->differenceWith(*A); }).printTable();
+    measureTime("Разность", inputs, [&] { return B->differenceWith(*A); }).printTable();
 
     std::cout << "\n5. Симметрическая разность (A △ B):\n";
-    measureTime([&] { return A->symmetricDifferenceWith(*B); }).printTable();
+    measureTime("Симметрическая разность", inputs, [&] { return A->symmetricDifferenceWith(*B); }).printTable();
 
     std::cout << "\n6. Дополнение A':\n";
-    measureTime([&] { return A->complement(); }).printTable();
+    if (A->isSparse()) {
+        std::cout << "   Недоступно в разреженном режиме\n";
+    } else {
+        measureTime("Дополнение", A->countNonZero(), [&] { return A->complement(); }).printTable();
+    }
 
     std::cout << "\n7. Дополнение B':\n";
-    measureTime([&] { return B->complement(); }).printTable();
+    if (B->isSparse()) {
+        std::cout << "   Недоступно в разреженном режиме\n";
+    } else {
+        measureTime("Дополнение", B->countNonZero(), [&] { return B->complement(); }).printTable();
+    }
 
     printSeparator();
     std::cout << "Арифметические операции:\n";
     printSeparator();
 
     std::cout << "\n8. Сумма (A + B):\n";
-    measureTime([&] { return A->arithmeticSum(*B); }).printTable();
+    measureTime("Арифметическая сумма", inputs, [&] { return A->arithmeticSum(*B); }).printTable();
 
     std::cout << "\n9. Разность (A - B):\n";
-    measureTime([&] { return A->arithmeticDifference(*B); }).printTable();
+    measureTime("Арифметическая разность", inputs, [&] { return A->arithmeticDifference(*B); }).printTable();
 
     std::cout << "\n10. Произведение (A * B):\n";
-    measureTime([&] { return A->arithmeticProduct(*B); }).printTable();
+    measureTime("Арифметическое произведение", inputs, [&] { return A->arithmeticProduct(*B); }).printTable();
 
     std::cout << "\n11. Деление (A / B):\n";
-    measureTime([&] { return A->arithmeticDivision(*B); }).printTable();
+    measureTime("Арифметическое деление", inputs, [&] { return A->arithmeticDivision(*B); }).printTable();
 
     printSeparator();
 
     pause();
 }
 
+namespace {
+
+uint64_t resultElements(const AnyMultiset& ms) {
+    return static_cast<uint64_t>(ms.countNonZero());
+}
+
+uint64_t resultElements(const ImportReport& report) {
+    return report.rowsRead;
+}
+
+}
+
 template<typename Func>
-auto CLIUI::measureTime(Func func) -> decltype(func()) {
-    auto start = std::chrono::high_resolution_clock::now();
+auto CLIUI::measureTime(const std::string& opName, uint64_t inputElements, Func func) -> decltype(func()) {
+    perf.start();
     auto result = func();
-    auto end = std::chrono::high_resolution_clock::now();
-
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    double milliseconds = duration.count() / 1000.0;
+    PerfSample sample = perf.stop(inputElements + resultElements(result));
 
-    printSlowWarning(milliseconds);
+    perf.record(opName, sample);
+    printSlowWarning(sample.wallMs);
 
     if (showTimings) {
-        printExecutionTime(milliseconds);
+        printExecutionTime(sample);
     }
 
     return result;
 }
 
 template<typename Func>
-void CLIUI::measureTimeVoid(Func func) {
-    auto start = std::chrono::high_resolution_clock::now();
+void CLIUI::measureTimeVoid(const std::string& opName, uint64_t elements, Func func) {
+    perf.start();
     func();
-    auto end = std::chrono::high_resolution_clock::now();
+    PerfSample sample = perf.stop(elements);
 
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    double milliseconds = duration.count() / 1000.0;
-
-    printSlowWarning(milliseconds);
+    perf.record(opName, sample);
+    printSlowWarning(sample.wallMs);
 
     if (showTimings) {
-        printExecutionTime(milliseconds);
+        printExecutionTime(sample);
     }
 }
 
@@ -597,7 +709,9 @@ void CLIUI::printSlowWarning(double milliseconds) {
     }
 }
 
-void CLIUI::printExecutionTime(double milliseconds) {
+void CLIUI::printExecutionTime(const PerfSample& sample) {
+    double milliseconds = sample.wallMs;
+
     std::cout << "\n  Время выполнения: ";
 
     if (milliseconds < 1.0) {
@@ -608,5 +722,172 @@ void CLIUI::printExecutionTime(double milliseconds) {
         std::cout << std::fixed << std::setprecision(3) << (milliseconds / 1000.0) << " с";
     }
 
-    std::cout << "\n";
+    std::cout << " (ЦП: " << std::fixed << std::setprecision(3) << sample.cpuMs << " мс)\n";
+    std::cout << "  Выделений памяти: " << sample.allocations
+              << " (" << sample.bytesAllocated << " байт), элементов: " << sample.elements << "\n";
+
+    if (sample.hasHardware) {
+        std::cout << "  Тактов: " << sample.cycles << ", промахов кэша: " << sample.cacheMisses << "\n";
+    }
+}
+
+namespace {
+
+const int FIXED_CHECK_ROUNDS = 2000;
+const int FIXED_CHECK_OPERATIONS = 9;
+
+const char* const FIXED_CHECK_NAMES[FIXED_CHECK_OPERATIONS] = {
+    "объединение", "пересечение", "разность", "симметрическая разность", "дополнение",
+    "арифметическая сумма", "арифметическая разность", "произведение", "деление",
+};
+
+// одна и та же операция для Multiset и FixedMultiset: имена методов совпадают
+template<typename M>
+M applyCheckedOperation(const M& a, const M& b, int op) {
+    switch (op) {
+        case 0: return a.unionWith(b);
+        case 1: return a.intersectionWith(b);
+        case 2: return a.differenceWith(b);
+        case 3: return a.symmetricDifferenceWith(b);
+        case 4: return a.complement();
+        case 5: return a.arithmeticSum(b);
+        case 6: return a.arithmeticDifference(b);
+        case 7: return a.arithmeticProduct(b);
+        default: return a.arithmeticDivision(b);
+    }
+}
+
+// Случайное мультимножество: примерно половина элементов ненулевая
+Multiset randomMultiset(const Universe& u, std::mt19937_64& gen) {
+    std::uniform_int_distribution<uint64_t> multDistrib(1, u.getMaxMultiplicity());
+    std::vector<uint64_t> codes;
+    std::vector<uint64_t> counts;
+    for (uint64_t code = 0; code < u.size(); ++code) {
+        if (gen() & 1) {
+            codes.push_back(code);
+            counts.push_back(multDistrib(gen));
+        }
+    }
+    Multiset ms(u);
+    ms.fillSorted(std::move(codes), std::move(counts));
+    return ms;
+}
+
+// Сверка FixedMultiset<Depth, MaxMult> с Multiset на случайных парах:
+// результаты всех операций должны совпадать; печатается суммарное время
+// обеих реализаций
+template<int Depth, uint64_t MaxMult>
+bool checkFixedMultiset(std::mt19937_64& gen) {
+    using Fixed = FixedMultiset<Depth, MaxMult>;
+    using Clock = std::chrono::steady_clock;
+
+    // конструктор универсума печатает сводку, здесь она не нужна
+    std::ostringstream silent;
+    std::streambuf* output = std::cout.rdbuf(silent.rdbuf());
+    Universe u(Depth, static_cast<long long>(MaxMult));
+    std::cout.rdbuf(output);
+
+    std::chrono::duration<double, std::milli> dynamicTime{}, fixedTime{};
+    int mismatches = 0;
+    for (int round = 0; round < FIXED_CHECK_ROUNDS; ++round) {
+        Multiset a = randomMultiset(u, gen);
+        Multiset b = randomMultiset(u, gen);
+        Fixed fixedA(a), fixedB(b);
+
+        for (int op = 0; op < FIXED_CHECK_OPERATIONS; ++op) {
+            Clock::time_point start = Clock::now();
+            Multiset expected = applyCheckedOperation(a, b, op);
+            dynamicTime += Clock::now() - start;
+
+            start = Clock::now();
+            Fixed actual = applyCheckedOperation(fixedA, fixedB, op);
+            fixedTime += Clock::now() - start;
+
+            if (actual != Fixed(expected)) {
+                if (mismatches == 0) {
+                    std::cout << "  Расхождение: разрядность " << Depth << ", " << FIXED_CHECK_NAMES[op] << "\n";
+                }
+                ++mismatches;
+            }
+        }
+    }
+
+    // ширина колонок в символах, а setw считает байты UTF-8, поэтому
+    // метка совпадения дополняется пробелами вручную
+    std::cout << "  " << std::left << std::setw(14) << Depth << std::setw(12) << MaxMult
+              << (mismatches == 0 ? "да          " : "НЕТ         ")
+              << std::fixed << std::setprecision(2) << std::setw(15) << dynamicTime.count()
+              << fixedTime.count() << "\n";
+    return mismatches == 0;
+}
+
+}
+
+void CLIUI::fixedMultisetCheck() {
+    std::cout << "\n  Сверка FixedMultiset с Multiset: " << FIXED_CHECK_ROUNDS
+              << " случайных пар, " << FIXED_CHECK_OPERATIONS << " операций\n\n";
+    std::cout << "  Разрядность   Кратность   Совпадает   Multiset, мс   FixedMultiset, мс\n";
+
+    std::mt19937_64 gen(std::random_device{}());
+    bool ok = checkFixedMultiset<1, 100>(gen);
+    ok &= checkFixedMultiset<2, 100>(gen);
+    ok &= checkFixedMultiset<3, 100>(gen);
+    ok &= checkFixedMultiset<4, 100>(gen);
+    ok &= checkFixedMultiset<5, 100>(gen);
+    ok &= checkFixedMultiset<6, 100>(gen);
+    ok &= checkFixedMultiset<6, 1000>(gen);
+    ok &= checkFixedMultiset<6, 100000>(gen);
+
+    std::cout << "\n  " << (ok ? "Результаты совпадают" : "Обнаружены расхождения!") << "\n";
+}
+
+void CLIUI::timingMenu() {
+    clearScreen();
+    printHeader("ИЗМЕРЕНИЕ ПРОИЗВОДИТЕЛЬНОСТИ");
+
+    std::cout << "  Отображение замеров: " << (showTimings ? "включено" : "выключено") << "\n";
+    std::cout << "  Аппаратные счётчики: " << (perf.hardwareAvailable() ? "доступны" : "недоступны") << "\n\n";
+
+    std::cout << "Выберите действие:\n";
+    std::cout << "  [1] " << (showTimings ? "Скрыть" : "Показать") << " замеры после операций\n";
+    std::cout << "  [2] Сводка за сессию\n";
+    std::cout << "  [3] Экспорт сводки в JSON\n";
+    std::cout << "  [4] Сбросить статистику\n";
+    std::cout << "  [5] Сверка FixedMultiset с Multiset (разрядность 1.." << FIXED_MAX_DEPTH << ")\n";
+    std::cout << "  [0] Назад\n";
+    std::cout << "Ваш выбор: ";
+
+    int choice;
+    std::cin >> choice;
+
+    switch (choice) {
+        case 1:
+            showTimings = !showTimings;
+            std::cout << "\n  Отображение замеров: " << (showTimings ? "включено" : "выключено") << "\n";
+            break;
+        case 2:
+            std::cout << "\n";
+            perf.printSummary();
+            break;
+        case 3:
+            try {
+                perf.exportJSON(inputFilePath("Путь к JSON-файлу: "));
+                std::cout << "\n Сводка сохранена\n";
+            } catch (const std::exception& e) {
+                std::cout << "\n Ошибка: " << e.what() << "\n";
+            }
+            break;
+        case 4:
+            perf.reset();
+            std::cout << "\n  Статистика сброшена\n";
+            break;
+        case 5:
+            fixedMultisetCheck();
+            break;
+        case 0: return;
+        default:
+            std::cout << " Неверный выбор!\n";
+    }
+
+    pause();
 }
@@ -1,26 +1,29 @@
 #pragma once
 
 #include "universe.h"
-#include "multiset.h"
+#include "anymultiset.h"
+#include "perfcounters.h"
 #include <map>
 #include <string>
 #include <memory>
 #include <iostream>
 #include <limits>
-#include <chrono>
 
 class CLIUI {
 private:
     std::unique_ptr<Universe> universe;
-    std::map<std::string, std::unique_ptr<Multiset>> multisets;
+    std::map<std::string, std::unique_ptr<AnyMultiset>> multisets;
     bool showTimings = false;
+    PerfCounters perf;
 
     void clearScreen();
     void pause();
     void printHeader(const std::string& title);
     void printSeparator();
     std::string inputMultisetName(const std::string& prompt);
-    Multiset* getMultiset(const std::string& name);
+    std::string inputFilePath(const std::string& prompt);
+    int inputFileFormat();
+    AnyMultiset* getMultiset(const std::string& name);
 
     void showMainMenu();
     void createUniverseMenu();
@@ -29,26 +32,29 @@ private:
     void operationsMenu();
     void arithmeticOperationsMenu();
     void compareMultisetsMenu();
+    void exportMultisetMenu();
 
     void performBinaryOperation(
         const std::string& opName,
-        Multiset (Multiset::*operation)(const Multiset&) const
+        AnyMultiset (AnyMultiset::*operation)(const AnyMultiset&) const
     );
 
     void performUnaryOperation(
         const std::string& opName,
-        Multiset (Multiset::*operation)() const
+        AnyMultiset (AnyMultiset::*operation)() const
     );
 
     void showAllOperations();
 
     template<typename Func>
-    auto measureTime(Func func) -> decltype(func());
+    auto measureTime(const std::string& opName, uint64_t inputElements, Func func) -> decltype(func());
 
     template<typename Func>
-    void measureTimeVoid(Func func);
+    void measureTimeVoid(const std::string& opName, uint64_t elements, Func func);
 
-    void printExecutionTime(double milliseconds);
+    void timingMenu();
+    void fixedMultisetCheck();
+    void printExecutionTime(const PerfSample& sample);
     void printSlowWarning(double milliseconds);
 
 public:
@@ -1,4 +1,7 @@
 static const int RECOMMENDED_MAX_DEPTH = 20;
-static const int MAX_DEPTH = 30;
+static const int MAX_DEPTH = 63;
+static const int MAX_DENSE_DEPTH = RECOMMENDED_MAX_DEPTH;
+static const int SPARSE_RANDOM_FILL_LIMIT = 1 << 12;
 static const int PRINT_IN_TABLE_VIEW = 10;
 static const int TABLE_MODE_DEPTH_TOGGLE = 12;
+static const int FIXED_MAX_DEPTH = 6;
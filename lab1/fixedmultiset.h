@@ -0,0 +1,181 @@
+#pragma once
+#include <array>
+#include <utility>
+#include "multiset.h"
+
+// Мультимножество над универсумом фиксированной малой разрядности (до FIXED_MAX_DEPTH).
+// Кратности хранятся плотным массивом, индексированным значением кода Грея,
+// тип счётчика - наименьший беззнаковый, вмещающий MaxMult. Таблицы кода Грея
+// строятся на этапе компиляции, поэлементные операции развёрнуты через
+// index_sequence и не содержат ветвлений.
+template<int Depth, uint64_t MaxMult>
+class FixedMultiset {
+    static_assert(Depth >= 1 && Depth <= FIXED_MAX_DEPTH, "Разрядность вне допустимого диапазона");
+
+public:
+    using Count = std::conditional_t<MaxMult <= UINT8_MAX, uint8_t,
+                  std::conditional_t<MaxMult <= UINT16_MAX, uint16_t,
+                  std::conditional_t<MaxMult <= UINT32_MAX, uint32_t, uint64_t>>>;
+
+    static constexpr size_t Size = size_t(1) << Depth;
+
+private:
+    std::array<Count, Size> counts{};
+
+    static constexpr std::array<uint8_t, Size> makeGrayTable() {
+        std::array<uint8_t, Size> table{};
+        for (size_t rank = 0; rank < Size; ++rank) {
+            table[rank] = static_cast<uint8_t>(rank ^ (rank >> 1));
+        }
+        return table;
+    }
+
+    static constexpr std::array<uint8_t, Size> makeRankTable() {
+        std::array<uint8_t, Size> table{};
+        for (size_t rank = 0; rank < Size; ++rank) {
+            table[rank ^ (rank >> 1)] = static_cast<uint8_t>(rank);
+        }
+        return table;
+    }
+
+    template<typename Op, size_t... I>
+    constexpr FixedMultiset apply(const FixedMultiset& other, Op op, std::index_sequence<I...>) const {
+        FixedMultiset result;
+        ((result.counts[I] = op(counts[I], other.counts[I])), ...);
+        return result;
+    }
+
+    template<typename Op>
+    constexpr FixedMultiset apply(const FixedMultiset& other, Op op) const {
+        return apply(other, op, std::make_index_sequence<Size>{});
+    }
+
+    static constexpr Count maxCount() {
+        return static_cast<Count>(MaxMult);
+    }
+
+public:
+    // ранг в последовательности Грея -> код и обратно
+    static constexpr std::array<uint8_t, Size> grayTable = makeGrayTable();
+    static constexpr std::array<uint8_t, Size> rankTable = makeRankTable();
+
+    constexpr FixedMultiset() = default;
+
+    template<typename C>
+    explicit FixedMultiset(const BasicMultiset<C>& ms) {
+        if (ms.getDepth() != Depth || ms.getMaxMultiplicity() != MaxMult) {
+            throw std::invalid_argument("Параметры универсума не совпадают с FixedMultiset");
+        }
+
+        const auto& codes = ms.getCodes();
+        const auto& msCounts = ms.getCounts();
+        for (size_t i = 0; i < codes.size(); ++i) {
+            counts[codes[i]] = static_cast<Count>(msCounts[i]);
+        }
+    }
+
+    // Преобразование обратно в Multiset над универсумом u той же разрядности
+    template<typename C = uint64_t>
+    BasicMultiset<C> toMultiset(const Universe& u) const {
+        if (u.getDepth() != Depth || u.getMaxMultiplicity() != MaxMult) {
+            throw std::invalid_argument("Параметры универсума не совпадают с FixedMultiset");
+        }
+
+        std::vector<uint64_t> codes;
+        std::vector<C> msCounts;
+        for (size_t code = 0; code < Size; ++code) {
+            if (counts[code] > 0) {
+                codes.push_back(code);
+                msCounts.push_back(static_cast<C>(counts[code]));
+            }
+        }
+
+        BasicMultiset<C> result(u);
+        result.fillSorted(std::move(codes), std::move(msCounts));
+        return result;
+    }
+
+    constexpr Count getMultiplicity(uint64_t code) const {
+        return counts[code];
+    }
+
+    constexpr void setMultiplicity(uint64_t code, Count m) {
+        if (code >= Size || m > maxCount()) {
+            throw std::invalid_argument("Некорректный элемент или кратность");
+        }
+        counts[code] = m;
+    }
+
+    constexpr Count getMultiplicityByRank(uint64_t rank) const {
+        return counts[grayTable[rank]];
+    }
+
+    constexpr FixedMultiset unionWith(const FixedMultiset& other) const {
+        return apply(other, [](Count a, Count b) { return branchlessMax(a, b); });
+    }
+
+    constexpr FixedMultiset intersectionWith(const FixedMultiset& other) const {
+        return apply(other, [](Count a, Count b) { return branchlessMin(a, b); });
+    }
+
+    constexpr FixedMultiset differenceWith(const FixedMultiset& other) const {
+        return apply(other, [](Count a, Count b) {
+            return branchlessMin(a, saturatingSub(maxCount(), b));
+        });
+    }
+
+    constexpr FixedMultiset symmetricDifferenceWith(const FixedMultiset& other) const {
+        return differenceWith(other).unionWith(other.differenceWith(*this));
+    }
+
+    constexpr FixedMultiset complement() const {
+        return apply(*this, [](Count a, Count) { return saturatingSub(maxCount(), a); });
+    }
+
+    constexpr FixedMultiset arithmeticSum(const FixedMultiset& other) const {
+        return apply(other, [](Count a, Count b) {
+            return branchlessMin(saturatingAdd(a, b), maxCount());
+        });
+    }
+
+    constexpr FixedMultiset arithmeticDifference(const FixedMultiset& other) const {
+        return apply(other, [](Count a, Count b) { return saturatingSub(a, b); });
+    }
+
+    constexpr FixedMultiset arithmeticProduct(const FixedMultiset& other) const {
+        return apply(other, [](Count a, Count b) {
+            return branchlessMin(saturatingMul(a, b), maxCount());
+        });
+    }
+
+    constexpr FixedMultiset arithmeticDivision(const FixedMultiset& other) const {
+        // деление на 0 даёт 0: делитель подменяется единицей, результат обнуляется маской
+        return apply(other, [](Count a, Count b) {
+            Count divisor = static_cast<Count>(b | Count(b == 0));
+            return static_cast<Count>((a / divisor) & allOnesIf<Count>(b != 0));
+        });
+    }
+
+    constexpr int countNonZero() const {
+        int count = 0;
+        for (size_t code = 0; code < Size; ++code) {
+            count += counts[code] != 0;
+        }
+        return count;
+    }
+
+    constexpr bool isEmpty() const {
+        return countNonZero() == 0;
+    }
+
+    constexpr bool operator==(const FixedMultiset& other) const {
+        for (size_t code = 0; code < Size; ++code) {
+            if (counts[code] != other.counts[code]) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const FixedMultiset& other) const {
+        return !(*this == other);
+    }
+};
@@ -1,14 +1,31 @@
 #include "multiset.h"
 #include <cmath>
+#include <set>
+
+template<typename Count>
+BasicMultiset<Count>::BasicMultiset(const Universe& u) : Universe(u) {
+    if (getMaxMultiplicity() > std::numeric_limits<Count>::max()) {
+        throw std::invalid_argument("Максимальная кратность " + std::to_string(getMaxMultiplicity())
+                                    + " не помещается в тип счётчика (максимум "
+                                    + std::to_string(uint64_t(std::numeric_limits<Count>::max())) + ")");
+    }
+};
 
-Multiset::Multiset(const Universe& u) : Universe(u) {};
+template<typename Count>
+Count BasicMultiset<Count>::maxCount() const {
+    return static_cast<Count>(getMaxMultiplicity());
+}
 
-void Multiset::fillManual(int targetSize) {
-    if (targetSize <= 0 || targetSize > size()) {
+template<typename Count>
+void BasicMultiset<Count>::fillManual(int targetSize) {
+    if (targetSize <= 0 || static_cast<uint64_t>(targetSize) > size()) {
         throw std::invalid_argument("Размер должен быть от 1 до размера универсума");
     }
 
-    elements.clear();
+    codes.clear();
+    counts.clear();
+
+    std::set<uint64_t> entered;
 
     std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
     std::cout << "║          РУЧНОЕ ЗАПОЛНЕНИЕ МУЛЬТИМНОЖЕСТВА             ║\n";
@@ -19,20 +36,21 @@ void Multiset::fillManual(int targetSize) {
 
     for (int i = 0; i < targetSize; ++i) {
         std::string element;
-        int multiplicity;
+        long long multiplicity;
 
         std::cout << "  Элемент " << (i + 1) << "/" << targetSize << "\n";
         std::cout << "  Код Грея: ";
         std::cin >> element;
 
-        if (!contains(element)) {
+        uint64_t code;
+        if (!parseCode(element, code)) {
             std::cout << "  Ошибка: элемент не принадлежит универсуму!\n";
             std::cout << "  Попробуйте снова.\n\n";
             --i;
             continue;
         }
 
-        if (elements.count(element)) {
+        if (entered.count(code)) {
             std::cout << "  Ошибка: элемент уже добавлен!\n";
             std::cout << "  Выберите другой элемент.\n\n";
             --i;
@@ -50,7 +68,7 @@ void Multiset::fillManual(int targetSize) {
             continue;
         }
 
-        if (multiplicity < 0 || multiplicity > getMaxMultiplicity()) {
+        if (multiplicity < 0 || static_cast<uint64_t>(multiplicity) > getMaxMultiplicity()) {
             std::cout << "  Ошибка: кратность должна быть от 0 до "
                       << getMaxMultiplicity() << "!\n";
             std::cout << "  Попробуйте снова.\n\n";
@@ -58,7 +76,8 @@ void Multiset::fillManual(int targetSize) {
             continue;
         }
 
-        elements[element] = multiplicity;
+        entered.insert(code);
+        setMultiplicity(code, multiplicity);
         std::cout << "   Элемент " << element << " с кратностью "
                   << multiplicity << " добавлен!\n\n";
     }
@@ -66,191 +85,319 @@ void Multiset::fillManual(int targetSize) {
     std::cout << "  Мультимножество успешно заполнено!\n\n";
 }
 
-void Multiset::fillRandom() {
-    elements.clear();
+template<typename Count>
+void BasicMultiset<Count>::fillRandom() {
+    codes.clear();
+    counts.clear();
+
+    // пустой универсум (кратность 0): выбирать нечего, а в разреженном
+    // режиме диапазон кодов [0, size() - 1] оказался бы [0, UINT64_MAX]
+    if (size() == 0) return;
 
     int minRandom = 1;
 
     if (getMaxMultiplicity() == 0) minRandom = 0;
 
     std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937_64 gen(rd());
+
+    // в разреженном режиме перемешать весь универсум невозможно,
+    // поэтому выбираются случайные различные коды
+    std::vector<uint64_t> chosen;
+
+    if (isSparse()) {
+        std::uniform_int_distribution<int> sizeDistrib(minRandom, SPARSE_RANDOM_FILL_LIMIT);
+        int targetSize = sizeDistrib(gen);
+
+        std::uniform_int_distribution<uint64_t> codeDistrib(0, size() - 1);
+        std::set<uint64_t> used;
+        while (static_cast<int>(chosen.size()) < targetSize) {
+            uint64_t code = codeDistrib(gen);
+            if (used.insert(code).second) {
+                chosen.push_back(code);
+            }
+        }
+    } else {
+        std::uniform_int_distribution<uint64_t> sizeDistrib(minRandom, size());
+        uint64_t targetSize = sizeDistrib(gen);
 
-    std::uniform_int_distribution<> sizeDistrib(minRandom, size());
-    int targetSize = sizeDistrib(gen);
+        std::vector<uint64_t> allCodes(size());
+        for (uint64_t rank = 0; rank < size(); ++rank) {
+            allCodes[rank] = grayCode(rank);
+        }
+        std::shuffle(allCodes.begin(), allCodes.end(), gen);
 
-    std::vector<std::string> allElements = getElements();
-    std::shuffle(allElements.begin(), allElements.end(), gen);
+        allCodes.resize(targetSize);
+        chosen = std::move(allCodes);
+    }
 
-    std::uniform_int_distribution<> multDistrib(minRandom, getMaxMultiplicity());
+    std::uniform_int_distribution<uint64_t> multDistrib(minRandom, getMaxMultiplicity());
 
     std::cout << "\n  Автоматическое заполнение...\n";
 
-    for (int i = 0; i < targetSize; ++i) {
-        int mult = multDistrib(gen);
-        elements[allElements[i]] = mult;
-        std::cout << "  • " << allElements[i] << " → кратность: " << mult << "\n";
+    std::vector<std::pair<uint64_t, Count>> filled;
+    filled.reserve(chosen.size());
+
+    for (uint64_t code : chosen) {
+        Count mult = static_cast<Count>(multDistrib(gen));
+        filled.emplace_back(code, mult);
+        std::cout << "  • " << codeToString(code) << " → кратность: " << uint64_t(mult) << "\n";
+    }
+
+    std::sort(filled.begin(), filled.end());
+    codes.reserve(filled.size());
+    counts.reserve(filled.size());
+    for (const auto& [code, mult] : filled) {
+        if (mult > 0) {
+            codes.push_back(code);
+            counts.push_back(mult);
+        }
     }
 
     std::cout << "\n  Мультимножество заполнено случайно!\n\n";
 }
 
-int Multiset::getMultiplicity(const std::string& element) const {
-    auto it = elements.find(element);
-    return (it != elements.end()) ? it->second : 0;
+// Быстрое заполнение из уже проверенных данных: коды строго возрастают,
+// кратности не превышают максимальную; нулевые кратности отбрасываются.
+template<typename Count>
+void BasicMultiset<Count>::fillSorted(std::vector<uint64_t> sortedCodes, std::vector<Count> sortedCounts) {
+    if (sortedCodes.size() != sortedCounts.size()) {
+        throw std::invalid_argument("Количество кодов и кратностей не совпадает");
+    }
+
+    // порядок проверяется по всем входным кодам, включая строки с нулевой
+    // кратностью, которые в результат не попадают
+    size_t kept = 0;
+    uint64_t previous = 0;
+    for (size_t i = 0; i < sortedCodes.size(); ++i) {
+        if (!containsCode(sortedCodes[i]) || sortedCounts[i] > maxCount()
+            || (i > 0 && previous >= sortedCodes[i])) {
+            throw std::invalid_argument("Некорректные данные для заполнения мультимножества");
+        }
+        previous = sortedCodes[i];
+        if (sortedCounts[i] == 0) continue;
+
+        sortedCodes[kept] = sortedCodes[i];
+        sortedCounts[kept] = sortedCounts[i];
+        ++kept;
+    }
+
+    sortedCodes.resize(kept);
+    sortedCounts.resize(kept);
+    codes = std::move(sortedCodes);
+    counts = std::move(sortedCounts);
+}
+
+template<typename Count>
+const std::vector<uint64_t>& BasicMultiset<Count>::getCodes() const {
+    return codes;
+}
+
+template<typename Count>
+const std::vector<Count>& BasicMultiset<Count>::getCounts() const {
+    return counts;
 }
 
-void Multiset::setMultiplicity(const std::string& element, int m) {
-    if (!contains(element)) {
+template<typename Count>
+size_t BasicMultiset<Count>::findCode(uint64_t code) const {
+    return std::lower_bound(codes.begin(), codes.end(), code) - codes.begin();
+}
+
+template<typename Count>
+uint64_t BasicMultiset<Count>::getMultiplicity(const std::string& element) const {
+    uint64_t code;
+    return parseCode(element, code) ? getMultiplicity(code) : 0;
+}
+
+template<typename Count>
+uint64_t BasicMultiset<Count>::getMultiplicity(uint64_t code) const {
+    size_t pos = findCode(code);
+    return (pos < codes.size() && codes[pos] == code) ? counts[pos] : 0;
+}
+
+template<typename Count>
+void BasicMultiset<Count>::setMultiplicity(const std::string& element, uint64_t m) {
+    uint64_t code;
+    if (!parseCode(element, code)) {
         throw std::invalid_argument("Элемент не принадлежит универсуму");
     }
 
-    if (m < 0 || m > getMaxMultiplicity()) {
+    setMultiplicity(code, m);
+}
+
+template<typename Count>
+void BasicMultiset<Count>::setMultiplicity(uint64_t code, uint64_t m) {
+    if (!containsCode(code)) {
+        throw std::invalid_argument("Элемент не принадлежит универсуму");
+    }
+
+    if (m > getMaxMultiplicity()) {
         throw std::invalid_argument("Кратность должна быть от 0 до максимальной");
     }
 
+    size_t pos = findCode(code);
+    bool present = pos < codes.size() && codes[pos] == code;
+
     if (m == 0) {
-        elements.erase(element);
+        if (present) {
+            codes.erase(codes.begin() + pos);
+            counts.erase(counts.begin() + pos);
+        }
+    } else if (present) {
+        counts[pos] = static_cast<Count>(m);
     } else {
-        elements[element] = m;
+        codes.insert(codes.begin() + pos, code);
+        counts.insert(counts.begin() + pos, static_cast<Count>(m));
     }
 }
 
-Multiset Multiset::unionWith(const Multiset& other) const {
-    Multiset result(*this);
+// Слияние двух отсортированных списков ненулевых элементов за O(|A| + |B|).
+// keepLeft/keepRight - учитывать ли элементы, присутствующие только в A/только в B;
+// отсутствующий элемент имеет кратность 0, нулевые результаты не сохраняются.
+template<typename Count>
+template<typename Combine>
+BasicMultiset<Count> BasicMultiset<Count>::mergeWith(const BasicMultiset& other, bool keepLeft, bool keepRight,
+                                                     Combine combine) const {
+    BasicMultiset result(static_cast<const Universe&>(*this));
+
+    size_t i = 0, j = 0;
+    size_t n = codes.size(), m = other.codes.size();
+
+    while (i < n || j < m) {
+        uint64_t code;
+        Count a = 0, b = 0;
+
+        if (j == m || (i < n && codes[i] < other.codes[j])) {
+            if (!keepLeft) { ++i; continue; }
+            code = codes[i];
+            a = counts[i++];
+        } else if (i == n || other.codes[j] < codes[i]) {
+            if (!keepRight) { ++j; continue; }
+            code = other.codes[j];
+            b = other.counts[j++];
+        } else {
+            code = codes[i];
+            a = counts[i++];
+            b = other.counts[j++];
+        }
 
-    for (const auto& [element, count] : other.elements) {
-        int currentCount = result.getMultiplicity(element);
-        result.elements[element] = std::max(currentCount, count);
+        Count count = combine(a, b);
+        if (count > 0) {
+            result.codes.push_back(code);
+            result.counts.push_back(count);
+        }
     }
 
     return result;
 }
 
-Multiset Multiset::intersectionWith(const Multiset& other) const {
-    Multiset result(*this);
-    result.elements.clear();
-
-    for (const auto& [element, count] : elements) {
-        int otherCount = other.getMultiplicity(element);
-        if (otherCount > 0) {
-            result.elements[element] = std::min(count, otherCount);
-        }
-    }
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::unionWith(const BasicMultiset& other) const {
+    return mergeWith(other, true, true, [](Count a, Count b) {
+        return branchlessMax(a, b);
+    });
+}
 
-    return result;
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::intersectionWith(const BasicMultiset& other) const {
+    return mergeWith(other, false, false, [](Count a, Count b) {
+        return branchlessMin(a, b);
+    });
 }
 
-Multiset Multiset::differenceWith(const Multiset& other) const {
-    Multiset result(*this);
-    // A(not B)
-    return result.intersectionWith(other.complement());
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::differenceWith(const BasicMultiset& other) const {
+    // A(not B) = min(A, max - B), без построения плотного дополнения
+    Count maxMult = maxCount();
+    return mergeWith(other, true, false, [maxMult](Count a, Count b) {
+        return branchlessMin(a, saturatingSub(maxMult, b));
+    });
 }
 
-Multiset Multiset::symmetricDifferenceWith(const Multiset& other) const {
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::symmetricDifferenceWith(const BasicMultiset& other) const {
     // (A △ B) = (A ∪ B) \ (A ∩ B) = (A ∪ B)((not A) ∪ (not B)) =
     // (A(not A) ∪ B(not A) ∪ A(not B) ∪ B(not B)) =
     // B(not A) ∪ A(not B) = (B \ A) ∪ (A \ B) = (A \ B) ∪ (B \ A)
 
-    Multiset diff1 = this->differenceWith(other);
-    Multiset diff2 = other.differenceWith(*this);
+    BasicMultiset diff1 = this->differenceWith(other);
+    BasicMultiset diff2 = other.differenceWith(*this);
     return diff1.unionWith(diff2);
 }
 
-Multiset Multiset::complement() const {
-    Multiset result(*this);
-    result.elements.clear();
-
-    for (const auto& element : this->getElements()) {
-        int currentMult = getMultiplicity(element);
-
-        int complementMult = this->getMaxMultiplicity() - currentMult;
-        result.elements[element] = complementMult;
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::complement() const {
+    if (isSparse()) {
+        throw std::invalid_argument("Дополнение недоступно в разреженном режиме: результат содержит 2^"
+                                    + std::to_string(depth) + " элементов");
     }
 
-    return result;
-}
+    BasicMultiset result(static_cast<const Universe&>(*this));
 
-Multiset Multiset::arithmeticSum(const Multiset& other) const {
-    Multiset result(*this);
+    size_t pos = 0;
+    for (uint64_t code = 0; code < size(); ++code) {
+        Count currentMult = 0;
+        if (pos < codes.size() && codes[pos] == code) {
+            currentMult = counts[pos++];
+        }
 
-    for (const auto& [element, count] : other.elements) {
-        int currentCount = result.getMultiplicity(element);
-        int newCount = std::min(currentCount + count, getMaxMultiplicity());
-        result.elements[element] = newCount;
+        Count complementMult = saturatingSub(maxCount(), currentMult);
+        if (complementMult > 0) {
+            result.codes.push_back(code);
+            result.counts.push_back(complementMult);
+        }
     }
 
     return result;
 }
 
-Multiset Multiset::arithmeticDifference(const Multiset& other) const {
-    Multiset result(*this);
-    result.elements.clear();
-
-    for (const auto& element : this->getElements()) {
-        int countA = getMultiplicity(element);
-        int countB = other.getMultiplicity(element);
-
-        int diff = std::max(countA - countB, 0);
-        result.elements[element] = diff;
-    }
-
-    return result;
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::arithmeticSum(const BasicMultiset& other) const {
+    Count maxMult = maxCount();
+    return mergeWith(other, true, true, [maxMult](Count a, Count b) {
+        return branchlessMin(saturatingAdd(a, b), maxMult);
+    });
 }
 
-Multiset Multiset::arithmeticProduct(const Multiset& other) const {
-    Multiset result(*this);
-    result.elements.clear();
-
-    for (const auto& [element, count] : elements) {
-        int otherCount = other.getMultiplicity(element);
-        if (otherCount > 0) {
-            int product = std::min(count * otherCount, getMaxMultiplicity());
-            result.elements[element] = product;
-        }
-    }
-
-    return result;
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::arithmeticDifference(const BasicMultiset& other) const {
+    return mergeWith(other, true, false, [](Count a, Count b) {
+        return saturatingSub(a, b);
+    });
 }
 
-Multiset Multiset::arithmeticDivision(const Multiset& other) const {
-    Multiset result(*this);
-    result.elements.clear();
-
-    for (const auto& [element, countA] : elements) {
-        int countB = other.getMultiplicity(element);
-
-        if (countB == 0) {
-            continue;
-        }
-
-        int quotient = countA / countB;
-
-        if (quotient > 0) {
-            result.elements[element] = quotient;
-        }
-    }
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::arithmeticProduct(const BasicMultiset& other) const {
+    Count maxMult = maxCount();
+    return mergeWith(other, false, false, [maxMult](Count a, Count b) {
+        return branchlessMin(saturatingMul(a, b), maxMult);
+    });
+}
 
-    return result;
+template<typename Count>
+BasicMultiset<Count> BasicMultiset<Count>::arithmeticDivision(const BasicMultiset& other) const {
+    return mergeWith(other, false, false, [](Count a, Count b) {
+        return static_cast<Count>(a / b);
+    });
 }
 
-bool Multiset::operator==(const Multiset& other) const {
-    return elements == other.elements;
+template<typename Count>
+bool BasicMultiset<Count>::operator==(const BasicMultiset& other) const {
+    return codes == other.codes && counts == other.counts;
 }
 
-bool Multiset::operator!=(const Multiset& other) const {
+template<typename Count>
+bool BasicMultiset<Count>::operator!=(const BasicMultiset& other) const {
     return !(*this == other);
 }
 
-int Multiset::countNonZero() const {
-    int count = 0;
-    for (const auto& [element, mult] : elements) {
-        if (mult > 0) ++count;
-    }
-    return count;
+template<typename Count>
+int BasicMultiset<Count>::countNonZero() const {
+    return static_cast<int>(codes.size());
 }
 
-void Multiset::printTable() const {
+template<typename Count>
+void BasicMultiset<Count>::printTable() const {
     if (isEmpty()) {
         std::cout << "   Пустое мультимножество\n\n";
         return;
@@ -263,40 +410,32 @@ void Multiset::printTable() const {
     }
 }
 
-void Multiset::printTableCompact() const {
+template<typename Count>
+void BasicMultiset<Count>::printTableCompact() const {
     std::cout << "  ┌────────┬──────────────┬──────────────┐\n";
     std::cout << "  │   №    │  Код Грея    │  Кратность   │\n";
     std::cout << "  ├────────┼──────────────┼──────────────┤\n";
 
-    int index = 1;
-    for (const auto& [element, count] : elements) {
-        if (count > 0) {
-            std::cout << "  │ " << std::setw(6) << index++ << " │ "
-                      << std::setw(12) << element << " │ "
-                      << std::setw(12) << count << " │\n";
-        }
+    for (size_t i = 0; i < codes.size(); ++i) {
+        std::cout << "  │ " << std::setw(6) << (i + 1) << " │ "
+                  << std::setw(12) << codeToString(codes[i]) << " │ "
+                  << std::setw(12) << uint64_t(counts[i]) << " │\n";
     }
 
     std::cout << "  └────────┴──────────────┴──────────────┘\n\n";
 }
 
-void Multiset::printTablePaged() const {
-    std::vector<std::pair<std::string, int>> nonZeroElements;
-    for (const auto& [element, count] : elements) {
-        if (count > 0) {
-            nonZeroElements.emplace_back(element, count);
-        }
-    }
-
-    int total = static_cast<int>(nonZeroElements.size());
+template<typename Count>
+void BasicMultiset<Count>::printTablePaged() const {
+    int total = countNonZero();
     std::cout << "  Элементы мультимножества (" << total << " шт.):\n\n";
 
     if (total > pow(2, TABLE_MODE_DEPTH_TOGGLE)) {
         std::cout << "  Первые элементы:\n";
         for (int i = 0; i < std::min(PRINT_IN_TABLE_VIEW, total); ++i) {
             std::cout << "    " << std::setw(6) << (i + 1) << ". "
-                    << nonZeroElements[i].first << " (×"
-                    << nonZeroElements[i].second << ")\n";
+                    << codeToString(codes[i]) << " (×"
+                    << uint64_t(counts[i]) << ")\n";
         }
 
         if (total > PRINT_IN_TABLE_VIEW * 2) {
@@ -308,8 +447,8 @@ void Multiset::printTablePaged() const {
             int start = std::max(PRINT_IN_TABLE_VIEW, total - PRINT_IN_TABLE_VIEW);
             for (int i = start; i < total; ++i) {
                 std::cout << "    " << std::setw(6) << (i + 1) << ". "
-                        << nonZeroElements[i].first << " (×"
-                        << nonZeroElements[i].second << ")\n";
+                        << codeToString(codes[i]) << " (×"
+                        << uint64_t(counts[i]) << ")\n";
             }
         }
 
@@ -317,20 +456,20 @@ void Multiset::printTablePaged() const {
     } else {
         for (int i = 0; i < total; ++i) {
             std::cout << "    " << std::setw(6) << (i + 1) << ". "
-                    << nonZeroElements[i].first << " (×"
-                    << nonZeroElements[i].second << ")\n";
+                    << codeToString(codes[i]) << " (×"
+                    << uint64_t(counts[i]) << ")\n";
         }
         std::cout << "\n";
     }
 
 }
 
-bool Multiset::isEmpty() const {
-    for (const auto& [element, count] : elements) {
-        if (count > 0) {
-            return false;
-        }
-    }
-
-    return true;
+template<typename Count>
+bool BasicMultiset<Count>::isEmpty() const {
+    return codes.empty();
 }
+
+template class BasicMultiset<uint8_t>;
+template class BasicMultiset<uint16_t>;
+template class BasicMultiset<uint32_t>;
+template class BasicMultiset<uint64_t>;
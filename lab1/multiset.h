@@ -1,28 +1,48 @@
 #pragma once
+#include <limits>
 #include "universe.h"
+#include "saturating.h"
+
+// Count - беззнаковый тип счётчика кратности (uint8_t, uint16_t, uint32_t, uint64_t)
+template<typename Count>
+class BasicMultiset : public Universe {
+    static_assert(std::is_unsigned<Count>::value, "Тип счётчика должен быть беззнаковым");
 
-class Multiset : public Universe {
 private:
-    std::map<std::string, int> elements;
+    // ненулевые элементы: коды Грея по возрастанию и их кратности
+    std::vector<uint64_t> codes;
+    std::vector<Count> counts;
+
+    template<typename Combine>
+    BasicMultiset mergeWith(const BasicMultiset& other, bool keepLeft, bool keepRight, Combine combine) const;
+
+    size_t findCode(uint64_t code) const;
+    Count maxCount() const;
 
 public:
-    Multiset(const Universe& u);
+    BasicMultiset(const Universe& u);
 
     void fillManual(int size);
     void fillRandom();
+    void fillSorted(std::vector<uint64_t> sortedCodes, std::vector<Count> sortedCounts);
 
-    int getMultiplicity(const std::string& element) const;
-    void setMultiplicity(const std::string& element, int m);
+    const std::vector<uint64_t>& getCodes() const;
+    const std::vector<Count>& getCounts() const;
 
-    Multiset unionWith(const Multiset& other) const;
-    Multiset intersectionWith(const Multiset& other) const;
-    Multiset differenceWith(const Multiset& other) const;
-    Multiset symmetricDifferenceWith(const Multiset& other) const;
-    Multiset complement() const;
-    Multiset arithmeticSum(const Multiset& other) const;
-    Multiset arithmeticDifference(const Multiset& other) const;
-    Multiset arithmeticProduct(const Multiset& other) const;
-    Multiset arithmeticDivision(const Multiset& other) const;
+    uint64_t getMultiplicity(const std::string& element) const;
+    uint64_t getMultiplicity(uint64_t code) const;
+    void setMultiplicity(const std::string& element, uint64_t m);
+    void setMultiplicity(uint64_t code, uint64_t m);
+
+    BasicMultiset unionWith(const BasicMultiset& other) const;
+    BasicMultiset intersectionWith(const BasicMultiset& other) const;
+    BasicMultiset differenceWith(const BasicMultiset& other) const;
+    BasicMultiset symmetricDifferenceWith(const BasicMultiset& other) const;
+    BasicMultiset complement() const;
+    BasicMultiset arithmeticSum(const BasicMultiset& other) const;
+    BasicMultiset arithmeticDifference(const BasicMultiset& other) const;
+    BasicMultiset arithmeticProduct(const BasicMultiset& other) const;
+    BasicMultiset arithmeticDivision(const BasicMultiset& other) const;
 
     int countNonZero() const;
     void printTable() const;
@@ -30,6 +50,13 @@ public:
     void printTablePaged() const;
 
     bool isEmpty() const;
-    bool operator!=(const Multiset& other) const;
-    bool operator==(const Multiset& other) const;
+    bool operator!=(const BasicMultiset& other) const;
+    bool operator==(const BasicMultiset& other) const;
 };
+
+extern template class BasicMultiset<uint8_t>;
+extern template class BasicMultiset<uint16_t>;
+extern template class BasicMultiset<uint32_t>;
+extern template class BasicMultiset<uint64_t>;
+
+using Multiset = BasicMultiset<uint64_t>;
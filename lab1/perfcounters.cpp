@@ -0,0 +1,230 @@
+#include "perfcounters.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocatedBytes{0};
+
+void* countedAlloc(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+double wallNowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+double cpuNowMs() {
+    return 1000.0 * static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string result;
+    for (char c : text) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            default: result += c;
+        }
+    }
+    return result;
+}
+
+}
+
+// Глобальная замена operator new/delete - источник счётчиков выделений памяти
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+void OperationStats::add(const PerfSample& sample) {
+    ++calls;
+    wallMs += sample.wallMs;
+    maxWallMs = std::max(maxWallMs, sample.wallMs);
+    cpuMs += sample.cpuMs;
+    allocations += sample.allocations;
+    bytesAllocated += sample.bytesAllocated;
+    elements += sample.elements;
+    cycles += sample.cycles;
+    cacheMisses += sample.cacheMisses;
+}
+
+PerfCounters::PerfCounters() {
+    openHardwareCounters();
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    if (cyclesFd >= 0) close(cyclesFd);
+    if (cacheMissesFd >= 0) close(cacheMissesFd);
+#endif
+}
+
+void PerfCounters::openHardwareCounters() {
+#ifdef __linux__
+    auto open = [](uint64_t config) {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    };
+
+    cyclesFd = open(PERF_COUNT_HW_CPU_CYCLES);
+    cacheMissesFd = open(PERF_COUNT_HW_CACHE_MISSES);
+
+    // без обоих счётчиков аппаратные данные не показываются вовсе
+    if (cyclesFd < 0 || cacheMissesFd < 0) {
+        if (cyclesFd >= 0) close(cyclesFd);
+        if (cacheMissesFd >= 0) close(cacheMissesFd);
+        cyclesFd = cacheMissesFd = -1;
+    }
+#endif
+}
+
+uint64_t PerfCounters::readCounter(int fd) {
+#ifdef __linux__
+    uint64_t value = 0;
+    if (fd >= 0 && read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+        return value;
+    }
+#else
+    (void)fd;
+#endif
+    return 0;
+}
+
+bool PerfCounters::hardwareAvailable() const {
+    return cyclesFd >= 0 && cacheMissesFd >= 0;
+}
+
+void PerfCounters::start() {
+    startAllocations = allocationCount.load(std::memory_order_relaxed);
+    startBytes = allocatedBytes.load(std::memory_order_relaxed);
+    startCycles = readCounter(cyclesFd);
+    startCacheMisses = readCounter(cacheMissesFd);
+    startCpu = cpuNowMs();
+    startWall = wallNowMs();
+}
+
+PerfSample PerfCounters::stop(uint64_t elements) {
+    PerfSample sample;
+    sample.wallMs = wallNowMs() - startWall;
+    sample.cpuMs = cpuNowMs() - startCpu;
+    sample.allocations = allocationCount.load(std::memory_order_relaxed) - startAllocations;
+    sample.bytesAllocated = allocatedBytes.load(std::memory_order_relaxed) - startBytes;
+    sample.elements = elements;
+
+    if (hardwareAvailable()) {
+        sample.hasHardware = true;
+        sample.cycles = readCounter(cyclesFd) - startCycles;
+        sample.cacheMisses = readCounter(cacheMissesFd) - startCacheMisses;
+    }
+
+    return sample;
+}
+
+void PerfCounters::record(const std::string& operation, const PerfSample& sample) {
+    stats[operation].add(sample);
+}
+
+void PerfCounters::reset() {
+    stats.clear();
+}
+
+void PerfCounters::printSummary() const {
+    if (stats.empty()) {
+        std::cout << "  Статистика пуста: операции ещё не выполнялись\n";
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (const auto& [name, s] : stats) {
+        std::cout << "  " << name << "\n";
+        std::cout << "    вызовов: " << s.calls
+                  << ", время: " << s.wallMs << " мс (макс. " << s.maxWallMs << " мс)"
+                  << ", ЦП: " << s.cpuMs << " мс\n";
+        std::cout << "    выделений: " << s.allocations
+                  << " (" << s.bytesAllocated << " байт)"
+                  << ", элементов: " << s.elements << "\n";
+        if (hardwareAvailable()) {
+            std::cout << "    тактов: " << s.cycles << ", промахов кэша: " << s.cacheMisses << "\n";
+        }
+    }
+
+    if (!hardwareAvailable()) {
+        std::cout << "\n  Аппаратные счётчики (perf_event_open) недоступны\n";
+    }
+}
+
+void PerfCounters::exportJSON(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Не удалось открыть файл: " + path);
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"hardwareCounters\": " << (hardwareAvailable() ? "true" : "false") << ",\n";
+    out << "  \"operations\": [";
+
+    bool first = true;
+    for (const auto& [name, s] : stats) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+
+        out << "    {\n";
+        out << "      \"name\": \"" << jsonEscape(name) << "\",\n";
+        out << "      \"calls\": " << s.calls << ",\n";
+        out << "      \"wallMs\": " << s.wallMs << ",\n";
+        out << "      \"maxWallMs\": " << s.maxWallMs << ",\n";
+        out << "      \"cpuMs\": " << s.cpuMs << ",\n";
+        out << "      \"allocations\": " << s.allocations << ",\n";
+        out << "      \"bytesAllocated\": " << s.bytesAllocated << ",\n";
+        out << "      \"elements\": " << s.elements;
+        if (hardwareAvailable()) {
+            out << ",\n      \"cycles\": " << s.cycles << ",\n";
+            out << "      \"cacheMisses\": " << s.cacheMisses;
+        }
+        out << "\n    }";
+    }
+
+    out << (first ? "]\n" : "\n  ]\n");
+    out << "}\n";
+
+    if (!out) {
+        throw std::runtime_error("Ошибка записи файла: " + path);
+    }
+}
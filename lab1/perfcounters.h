@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Замер одной операции
+struct PerfSample {
+    double wallMs = 0.0;
+    double cpuMs = 0.0;
+    uint64_t allocations = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t elements = 0;
+    uint64_t cycles = 0;
+    uint64_t cacheMisses = 0;
+    bool hasHardware = false;
+};
+
+// Накопленная по сессии статистика одной операции
+struct OperationStats {
+    uint64_t calls = 0;
+    double wallMs = 0.0;
+    double maxWallMs = 0.0;
+    double cpuMs = 0.0;
+    uint64_t allocations = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t elements = 0;
+    uint64_t cycles = 0;
+    uint64_t cacheMisses = 0;
+
+    void add(const PerfSample& sample);
+};
+
+// Счётчики производительности: время (реальное и процессорное), выделения памяти
+// (через замену глобального operator new) и, где доступно через perf_event_open,
+// аппаратные счётчики тактов и промахов кэша.
+class PerfCounters {
+private:
+    int cyclesFd = -1;
+    int cacheMissesFd = -1;
+
+    double startWall = 0.0;
+    double startCpu = 0.0;
+    uint64_t startAllocations = 0;
+    uint64_t startBytes = 0;
+    uint64_t startCycles = 0;
+    uint64_t startCacheMisses = 0;
+
+    std::map<std::string, OperationStats> stats;
+
+    void openHardwareCounters();
+    static uint64_t readCounter(int fd);
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool hardwareAvailable() const;
+
+    void start();
+    PerfSample stop(uint64_t elements);
+    void record(const std::string& operation, const PerfSample& sample);
+
+    void printSummary() const;
+    void exportJSON(const std::string& path) const;
+    void reset();
+};
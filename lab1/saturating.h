@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+// Беззнаковая арифметика с насыщением без ветвлений: результат, не помещающийся
+// в тип, заменяется на максимальное (или нулевое) значение вместо переполнения.
+
+template<typename T>
+constexpr T allOnesIf(bool condition) {
+    static_assert(std::is_unsigned<T>::value, "Ожидается беззнаковый тип");
+    return static_cast<T>(-static_cast<T>(condition));
+}
+
+template<typename T>
+constexpr T saturatingAdd(T a, T b) {
+    T sum = static_cast<T>(a + b);
+    return static_cast<T>(sum | allOnesIf<T>(sum < a));
+}
+
+template<typename T>
+constexpr T saturatingSub(T a, T b) {
+    T diff = static_cast<T>(a - b);
+    return static_cast<T>(diff & allOnesIf<T>(a >= b));
+}
+
+template<typename T>
+constexpr T saturatingMul(T a, T b) {
+    T product = 0;
+    bool overflow = __builtin_mul_overflow(a, b, &product);
+    return static_cast<T>(product | allOnesIf<T>(overflow));
+}
+
+template<typename T>
+constexpr T branchlessMin(T a, T b) {
+    return static_cast<T>(b ^ ((a ^ b) & allOnesIf<T>(a < b)));
+}
+
+template<typename T>
+constexpr T branchlessMax(T a, T b) {
+    return static_cast<T>(a ^ ((a ^ b) & allOnesIf<T>(a < b)));
+}
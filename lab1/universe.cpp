@@ -2,27 +2,34 @@
 
 Universe::Universe() : depth(0), maxMultiplicity(0) {};
 
-Universe::Universe(int depth, int maxMultiplicity)
-    : depth(depth), maxMultiplicity(maxMultiplicity) {
+Universe::Universe(int depth, long long maxMultiplicity)
+    : depth(depth), maxMultiplicity(0) {
 
     if (depth < 0) {
         throw std::invalid_argument("Разрядность должна быть неотрицательной");
     }
 
+    if (depth > MAX_DEPTH) {
+        throw std::invalid_argument("Разрядность слишком большая (максимум " + std::to_string(MAX_DEPTH) + ")");
+    }
+
     if (depth > RECOMMENDED_MAX_DEPTH && maxMultiplicity > 0) {
         std::cout << "\n  Предупреждение: разрядность " << depth
                   << " превышает рекомендуемое значение " << RECOMMENDED_MAX_DEPTH << "\n";
-        std::cout << "  Это может привести к большому потреблению памяти и времени выполнения.\n\n";
+        std::cout << "  Универсум работает в разреженном режиме: элементы не хранятся,\n";
+        std::cout << "  память расходуется только на ненулевые элементы мультимножеств.\n\n";
     }
 
     if (depth == 0) {
-        this->maxMultiplicity = 0;
+        maxMultiplicity = 0;
     }
 
-    if (this->maxMultiplicity < 0) {
+    if (maxMultiplicity < 0) {
         throw std::invalid_argument("Максимальная кратность должна быть неотрицательной");
     }
 
+    this->maxMultiplicity = static_cast<uint64_t>(maxMultiplicity);
+
     if (depth == 0 || this->maxMultiplicity == 0) {
         std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
         std::cout << "║              СОЗДАН ПУСТОЙ УНИВЕРСУМ                   ║\n";
@@ -32,12 +39,14 @@ Universe::Universe(int depth, int maxMultiplicity)
         return;
     }
 
-    elements = generateGrayCode(depth);
+    if (!isSparse()) {
+        elements = std::make_shared<const std::vector<std::string>>(generateGrayCode(depth));
+    }
 
     std::cout << "\n╔════════════════════════════════════════════════════════╗\n";
     std::cout << "║              УНИВЕРСУМ УСПЕШНО СОЗДАН                  ║\n";
     std::cout << "╚════════════════════════════════════════════════════════╝\n";
-    std::cout << "  Размер: " << elements.size() << " элементов (2^" << depth << ")\n";
+    std::cout << "  Размер: " << size() << " элементов (2^" << depth << ")\n";
     std::cout << "  Разрядность кода Грея: " << depth << "\n";
     std::cout << "  Максимальная кратность: " << this->maxMultiplicity << "\n\n";
 }
@@ -51,44 +60,101 @@ std::vector<std::string> Universe::generateGrayCode(int n) {
 
     std::vector<std::string> result;
 
-    if (n > 30) {
-        throw std::invalid_argument("Разрядность слишком большая (максимум 30 для безопасной работы с int)");
+    if (n > MAX_DENSE_DEPTH) {
+        throw std::invalid_argument("Разрядность слишком большая для материализации (максимум "
+                                    + std::to_string(MAX_DENSE_DEPTH) + ")");
     }
 
-    int total = 1 << n; // 2^n элементов
+    uint64_t total = uint64_t(1) << n; // 2^n элементов
+    result.reserve(total);
 
-    for (int i = 0; i < total; ++i) {
-        // формула кода Грея: gray = i XOR (i >> 1)
-        int gray = i ^ (i >> 1);
+    for (uint64_t i = 0; i < total; ++i) {
+        uint64_t gray = grayCode(i);
 
-        std::string binary;
-        for (int j = n - 1; j >= 0; --j) {
-            binary += ((gray >> j) & 1) ? '1' : '0';
+        std::string binary(n, '0');
+        for (int j = 0; j < n; ++j) {
+            if ((gray >> (n - 1 - j)) & 1) binary[j] = '1';
         }
-        result.push_back(binary);
+        result.push_back(std::move(binary));
     }
 
     return result;
 }
 
+uint64_t Universe::grayCode(uint64_t rank) {
+    // формула кода Грея: gray = i XOR (i >> 1)
+    return rank ^ (rank >> 1);
+}
+
+uint64_t Universe::grayRank(uint64_t code) {
+    // обратное преобразование: префиксный XOR всех старших разрядов
+    code ^= code >> 32;
+    code ^= code >> 16;
+    code ^= code >> 8;
+    code ^= code >> 4;
+    code ^= code >> 2;
+    code ^= code >> 1;
+    return code;
+}
+
 int Universe::getDepth() const {
     return depth;
 }
 
-int Universe::getMaxMultiplicity() const {
+uint64_t Universe::getMaxMultiplicity() const {
     return maxMultiplicity;
 }
 
 const std::vector<std::string>& Universe::getElements() const {
-    return elements;
+    static const std::vector<std::string> empty;
+    return elements ? *elements : empty;
+}
+
+bool Universe::isSparse() const {
+    return depth > MAX_DENSE_DEPTH;
+}
+
+std::string Universe::codeToString(uint64_t code) const {
+    std::string binary(depth, '0');
+    for (int j = 0; j < depth; ++j) {
+        if ((code >> (depth - 1 - j)) & 1) binary[j] = '1';
+    }
+    return binary;
+}
+
+bool Universe::parseCode(const std::string& element, uint64_t& code) const {
+    if (size() == 0 || static_cast<int>(element.size()) != depth) {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (char c : element) {
+        if (c != '0' && c != '1') return false;
+        value = (value << 1) | static_cast<uint64_t>(c - '0');
+    }
+
+    code = value;
+    return true;
+}
+
+std::string Universe::elementAt(uint64_t rank) const {
+    return codeToString(grayCode(rank));
 }
 
 bool Universe::contains(const std::string& element) const {
-    return std::find(elements.begin(), elements.end(), element) != elements.end();
+    uint64_t code;
+    return parseCode(element, code);
+}
+
+bool Universe::containsCode(uint64_t code) const {
+    return size() != 0 && (code >> depth) == 0;
 }
 
-int Universe::size() const {
-    return static_cast<int>(elements.size());
+uint64_t Universe::size() const {
+    if (depth == 0 || maxMultiplicity == 0) {
+        return 0;
+    }
+    return uint64_t(1) << depth;
 }
 
 void Universe::printTable() const {
@@ -120,9 +186,9 @@ void Universe::printTableCompact() const {
     std::cout << "  │   №    │   Элемент    │\n";
     std::cout << "  ├────────┼──────────────┤\n";
 
-    for (int i = 0; i < size(); ++i) {
+    for (uint64_t i = 0; i < size(); ++i) {
         std::cout << "  │ " << std::setw(6) << (i + 1) << " │ "
-                  << std::setw(12) << elements[i] << " │\n";
+                  << std::setw(12) << elementAt(i) << " │\n";
     }
 
     std::cout << "  └────────┴──────────────┘\n\n";
@@ -132,19 +198,21 @@ void Universe::printTablePaged() const {
     std::cout << "  Элементы универсума (" << size() << " шт.):\n\n";
 
     std::cout << "  Первые элементы:\n";
-    for (int i = 0; i < std::min(PRINT_IN_TABLE_VIEW, size()); ++i) {
-        std::cout << "    " << std::setw(6) << (i + 1) << ". " << elements[i] << "\n";
+    uint64_t view = PRINT_IN_TABLE_VIEW;
+
+    for (uint64_t i = 0; i < std::min(view, size()); ++i) {
+        std::cout << "    " << std::setw(6) << (i + 1) << ". " << elementAt(i) << "\n";
     }
 
-    if (size() > PRINT_IN_TABLE_VIEW * 2) {
-        std::cout << "\n    ... (" << (size() - PRINT_IN_TABLE_VIEW * 2) << " элементов пропущено) ...\n\n";
+    if (size() > view * 2) {
+        std::cout << "\n    ... (" << (size() - view * 2) << " элементов пропущено) ...\n\n";
     }
 
-    if (size() > PRINT_IN_TABLE_VIEW) {
+    if (size() > view) {
         std::cout << "  Последние элементы:\n";
-        int start = std::max(PRINT_IN_TABLE_VIEW, size() - PRINT_IN_TABLE_VIEW);
-        for (int i = start; i < size(); ++i) {
-            std::cout << "    " << std::setw(6) << (i + 1) << ". " << elements[i] << "\n";
+        uint64_t start = std::max(view, size() - view);
+        for (uint64_t i = start; i < size(); ++i) {
+            std::cout << "    " << std::setw(6) << (i + 1) << ". " << elementAt(i) << "\n";
         }
     }
 
@@ -2,6 +2,8 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
@@ -12,28 +14,38 @@
 
 class Universe {
     private:
-        std::vector<std::string> elements;
+        // материализуется только в плотном режиме (depth <= MAX_DENSE_DEPTH),
+        // копии универсума разделяют один и тот же список
+        std::shared_ptr<const std::vector<std::string>> elements;
 
         void printTableCompact() const;
         void printTablePaged() const;
 
     protected:
         int depth;
-        int maxMultiplicity;
+        uint64_t maxMultiplicity;
 
     public:
         Universe();
-        Universe(int depth, int maxMultiplicity);
+        Universe(int depth, long long maxMultiplicity);
         ~Universe();
 
         static std::vector<std::string> generateGrayCode(int n);
+        static uint64_t grayCode(uint64_t rank);
+        static uint64_t grayRank(uint64_t code);
 
         int getDepth() const;
-        int getMaxMultiplicity() const;
+        uint64_t getMaxMultiplicity() const;
         const std::vector<std::string>& getElements() const;
+        bool isSparse() const;
+
+        std::string codeToString(uint64_t code) const;
+        bool parseCode(const std::string& element, uint64_t& code) const;
+        std::string elementAt(uint64_t rank) const;
 
         bool contains(const std::string& element) const;
-        int size() const;
+        bool containsCode(uint64_t code) const;
+        uint64_t size() const;
 
         void print() const;
         void printTable() const;
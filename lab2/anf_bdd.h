@@ -0,0 +1,91 @@
+#pragma once
+#include "bdd_manager.h"
+#include "zdd.h"
+#include <unordered_map>
+
+// Прямые преобразования между полиномом Жегалкина и БДР без таблицы
+// истинности, по разложению Рида-Маллера f = f0 ⊕ x·(f0 ⊕ f1), где f0 и
+// f1 - кофакторы по x. Мономы без x образуют полином f0, мономы с x после
+// вычёркивания x - полином f0 ⊕ f1. Время зависит от числа мономов и
+// размеров диаграмм, а не от 2^n.
+class ANFConverter {
+private:
+    // Маски [begin, end) упорядочены по возрастанию и совпадают в битах
+    // переменных x1..x(var); старший бит маски - x1
+    static uint32_t buildBDD(BDDManager& manager, const uint64_t* begin, const uint64_t* end, int var) {
+        if (begin == end) return BDDManager::FALSE_NODE;
+        int n = manager.getNumVars();
+        if (var == n) return BDDManager::TRUE_NODE;
+
+        uint64_t bit = 1ULL << (n - 1 - var);
+        const uint64_t* middle = std::partition_point(begin, end, [bit](uint64_t mask) {
+            return (mask & bit) == 0;
+        });
+        uint32_t without = buildBDD(manager, begin, middle, var + 1);
+        if (middle == end) return without;
+        uint32_t with = buildBDD(manager, middle, end, var + 1);
+
+        // f0 = without, f1 = without ⊕ with; ite учитывает порядок переменных менеджера
+        return manager.ite(manager.variable(var), manager.apply(BDDOp::XOR, without, with), without);
+    }
+
+    static uint32_t buildANF(BDDManager& manager, uint32_t f, ZDDManager& zdd,
+                             std::unordered_map<uint32_t, uint32_t>& memo) {
+        if (manager.isTerminal(f)) {
+            return f == BDDManager::TRUE_NODE ? ZDDManager::BASE : ZDDManager::EMPTY;
+        }
+        auto found = memo.find(f);
+        if (found != memo.end()) {
+            return found->second;
+        }
+
+        const BDDNode& node = manager.node(f);
+        int var = node.varIndex;
+        uint32_t f0 = node.low, f1 = node.high;
+        uint32_t without = buildANF(manager, f0, zdd, memo);
+        uint32_t difference = buildANF(manager, manager.apply(BDDOp::XOR, f0, f1), zdd, memo);
+
+        // семейства без x и с x не пересекаются; JOIN с {{x}} не зависит от
+        // того, совпадает ли порядок переменных БДР с порядком ДРНП
+        uint32_t with = zdd.apply(ZDDOp::JOIN, zdd.single(var), difference);
+        uint32_t result = zdd.apply(ZDDOp::UNION, without, with);
+        memo[f] = result;
+        return result;
+    }
+
+public:
+    // БДР полинома с мономами masks (маски в нумерации строк таблицы
+    // истинности, повторы взаимно уничтожаются); корень без ссылки
+    static uint32_t toBDD(BDDManager& manager, std::vector<uint64_t> masks) {
+        if (manager.getNumVars() > 64) {
+            throw std::invalid_argument("Маски мономов задаются не более чем для 64 переменных");
+        }
+        std::sort(masks.begin(), masks.end());
+        size_t kept = 0;
+        for (size_t i = 0; i < masks.size();) {
+            size_t j = i;
+            while (j < masks.size() && masks[j] == masks[i]) ++j;
+            if ((j - i) % 2) masks[kept++] = masks[i];
+            i = j;
+        }
+        masks.resize(kept);
+        return buildBDD(manager, masks.data(), masks.data() + masks.size(), 0);
+    }
+
+    // Семейство мономов полинома Жегалкина функции f в менеджере ДРНП
+    // с тем же числом переменных; кофакторы разности f0 ⊕ f1 запоминаются
+    // по узлам БДР, так что каждый узел разлагается один раз
+    static uint32_t toZDD(BDDManager& manager, uint32_t f, ZDDManager& zdd) {
+        if (zdd.getNumVars() != manager.getNumVars()) {
+            throw std::invalid_argument("Число переменных ДРНП и БДР различается");
+        }
+        std::unordered_map<uint32_t, uint32_t> memo;
+        return buildANF(manager, f, zdd, memo);
+    }
+
+    // Маски мономов полинома Жегалкина функции f по возрастанию
+    static std::vector<uint64_t> toMonomials(BDDManager& manager, uint32_t f) {
+        ZDDManager zdd(manager.getNumVars());
+        return zdd.toMonomials(toZDD(manager, f, zdd));
+    }
+};
@@ -1,64 +1,240 @@
+#pragma once
 #include "zhegalkin.h"
-
-struct BDDNode {
-    int varIndex;   // -1 для листа
-    int value;      // значение листа
-    int low;        // потомок по 0
-    int high;       // потомок по 1
-};
+#include "anf_bdd.h"
+#include "compact_bdd.h"
+#include "sat_count.h"
+#include "zdd.h"
+#include <memory>
+#include <random>
 
 class BDD : public ZhegalkinPolynomial {
 private:
-    std::vector<BDDNode> nodes;
-    int root;
+    BDDManager manager;
+    uint32_t root;
 
-    void buildHardcodedBDD() {
-        nodes.push_back({-1, 0, -1, -1});  // [0] лист 0
-        nodes.push_back({-1, 1, -1, -1});  // [1] лист 1
+    // числа выполняющих наборов по узлам, считаются при первом обращении;
+    // снимок БДР в SatCounter не зависит от последующих перестановок
+    mutable std::shared_ptr<const SatCounter> satCounter;
 
-        nodes.push_back({2, 0, 0, 1});     // [2] x3
-        nodes.push_back({1, 0, 2, 1});     // [3] x2
-        nodes.push_back({1, 0, 0, 2});     // [4] x2
-        nodes.push_back({3, 0, 3, 4});     // [5] x4
-        nodes.push_back({0, 0, 5, 4});     // [6] x1
+    static constexpr int SAMPLES_SHOWN = 5;
+    static constexpr int CUBES_SHOWN = 16;
+    static constexpr size_t ZDD_NODES_SHOWN = 32;
+
+    // Перенумеровать узлы менеджера по уровням (см. BDDManager::compact)
+    void compactNodes() {
+        root = manager.compact()[root];
+    }
 
-        root = 6;
+    void build() {
+        root = manager.addRef(manager.fromTruthTable(table));
+        manager.setAutoReorder(ReorderMethod::SIFTING);
+        manager.reorderIfNeeded();
+        compactNodes();
     }
 
 public:
-    BDD(int n, const std::vector<int>& vals) : ZhegalkinPolynomial(n, vals) {
-        buildHardcodedBDD();
+    BDD(int n, const std::vector<int>& vals) : ZhegalkinPolynomial(n, vals), manager(n) {
+        build();
+    }
+
+    explicit BDD(const BitTable& t) : ZhegalkinPolynomial(t), manager(t.getNumVars()) {
+        build();
+    }
+
+    BDDManager& getManager() { return manager; }
+    const BDDManager& getManager() const { return manager; }
+    uint32_t getRoot() const { return root; }
+
+    void displayOrder() const {
+        std::cout << "Порядок переменных: ";
+        const std::vector<int>& order = manager.getOrder();
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (i > 0) std::cout << ", ";
+            std::cout << "x" << (order[i] + 1);
+        }
+        std::cout << "\n";
     }
 
     void displayBDD() {
         printHeader("БИНАРНАЯ ДИАГРАММА РЕШЕНИЙ (БДР)");
 
-        std::cout << "Порядок переменных: x1, x4, x2, x3\n\n";
-        std::cout << "Структура БДР:\n";
+        displayOrder();
+        std::cout << "\nСтруктура БДР:\n";
         printSeparator();
 
-        for (size_t i = 0; i < nodes.size(); ++i) {
-            std::cout << "  [" << i << "] ";
-            if (nodes[i].varIndex == -1) {
-                std::cout << "Лист: " << nodes[i].value << "\n";
+        std::vector<uint32_t> reachable = manager.reachableNodes(root);
+        for (uint32_t id : reachable) {
+            const BDDNode& node = manager.node(id);
+            std::cout << "  [" << id << "] ";
+            if (manager.isTerminal(id)) {
+                std::cout << "Лист: " << id << "\n";
             } else {
-                std::cout << "x" << (nodes[i].varIndex + 1)
-                          << " --0--> [" << nodes[i].low << "]"
-                          << ", --1--> [" << nodes[i].high << "]\n";
+                std::cout << "x" << (node.varIndex + 1)
+                          << " --0--> [" << node.low << "]"
+                          << ", --1--> [" << node.high << "]\n";
             }
         }
 
         std::cout << "\nКорень: [" << root << "]\n";
-        std::cout << "Всего узлов: " << nodes.size() << "\n";
+        std::cout << "Всего узлов: " << reachable.size() << "\n";
+        std::cout << "Узлов в уникальной таблице: " << manager.totalNodes() << "\n";
+        std::cout << "Обращений к кешу: " << manager.getCacheLookups()
+                  << ", попаданий: " << manager.getCacheHits() << "\n";
+    }
+
+    void reorderBDD() {
+        printHeader("ПЕРЕСТАНОВКА ПЕРЕМЕННЫХ БДР");
+
+        std::cout << "1. Просеивание (sifting)\n";
+        std::cout << "2. Перебор в окне из трёх уровней\n";
+        int method = getUserInput("Метод: ", 1, 2);
+
+        displayOrder();
+        ReorderStats stats = manager.reorder(method == 1 ? ReorderMethod::SIFTING
+                                                         : ReorderMethod::WINDOW);
+        compactNodes();
+        std::cout << "\nПосле перестановки:\n";
+        displayOrder();
+
+        std::cout << "Узлов до: " << stats.nodesBefore
+                  << ", после: " << stats.nodesAfter << "\n";
+        std::cout << "Обменов соседних уровней: " << stats.swaps << "\n";
+        std::cout << "Время: " << std::fixed << std::setprecision(3)
+                  << stats.timeMs << " мс\n";
     }
 
     int evaluateBDD(const std::vector<int>& input) const {
-        int current = root;
-        while (nodes[current].varIndex != -1) {
-            int var = nodes[current].varIndex;
-            current = (input[var] == 0) ? nodes[current].low : nodes[current].high;
+        return manager.evaluate(root, input);
+    }
+
+    CompactBDD toCompact() const {
+        return CompactBDD(manager, root);
+    }
+
+    // Пакетное вычисление по компактному представлению БДР
+    std::vector<uint64_t> evaluateBDDBatch(const std::vector<uint64_t>& inputs) const {
+        CompactBDD compact = toCompact();
+        return evaluateWords(inputs, [&compact](const uint64_t* group, size_t count) {
+            return compact.evaluate64(group, count);
+        });
+    }
+
+    const SatCounter& getSatCounter() const {
+        if (!satCounter) {
+            satCounter = std::make_shared<const SatCounter>(manager, root);
+        }
+        return *satCounter;
+    }
+
+    // Число выполняющих наборов - за один проход по узлам БДР
+    BigUInt satCount() const {
+        return getSatCounter().count();
+    }
+
+    template<typename Rng>
+    uint64_t randomSatisfying(Rng& rng) const {
+        return getSatCounter().sample(rng);
+    }
+
+    // Непересекающиеся кубы единиц функции по одному на вызов next
+    CubeEnumerator satisfyingCubes() const {
+        return CubeEnumerator(getSatCounter());
+    }
+
+    void displaySatisfying() {
+        printHeader("ВЫПОЛНЯЮЩИЕ НАБОРЫ");
+
+        BigUInt count = satCount();
+        std::cout << "Число выполняющих наборов: " << count.toString() << "\n";
+        if (count.isZero()) return;
+
+        std::cout << "\nСлучайные выполняющие наборы:\n";
+        std::mt19937_64 rng(std::random_device{}());
+        for (int k = 0; k < SAMPLES_SHOWN; ++k) {
+            uint64_t input = randomSatisfying(rng);
+            std::cout << "  (";
+            for (int j = 0; j < numVars; ++j) {
+                if (j > 0) std::cout << ", ";
+                std::cout << ((input >> (numVars - 1 - j)) & 1);
+            }
+            std::cout << ")\n";
+        }
+
+        std::cout << "\nНепересекающиеся кубы (пути в лист 1):\n";
+        CubeEnumerator cubes = satisfyingCubes();
+        Cube cube;
+        int shown = 0;
+        while (cubes.next(cube)) {
+            if (shown == CUBES_SHOWN) {
+                std::cout << "  ...\n";
+                break;
+            }
+            std::cout << "  ";
+            for (int j = 0; j < numVars; ++j) {
+                uint64_t bit = 1ULL << (numVars - 1 - j);
+                std::cout << (!(cube.care & bit) ? '-' : (cube.value & bit) ? '1' : '0');
+            }
+            std::cout << "\n";
+            ++shown;
+        }
+    }
+
+    // Мономы полинома Жегалкина как ДРНП (см. zdd.h) в сравнении с БДР
+    void displayZDD() {
+        printHeader("ДРНП МОНОМОВ ПОЛИНОМА ЖЕГАЛКИНА");
+
+        auto start = std::chrono::steady_clock::now();
+        ZDDManager zdd(numVars);
+        uint32_t family = zdd.addRef(zdd.fromCoefficients(getCoefficients()));
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        size_t nodes = zdd.countNodes(family);
+        std::cout << "Мономов: " << zdd.count(family).toString() << "\n";
+        std::cout << "Узлов ДРНП: " << nodes << "\n";
+        std::cout << "Узлов БДР функции: " << manager.countNodes(root) << "\n";
+        std::cout << "Время построения: " << std::fixed << std::setprecision(3) << ms << " мс\n";
+
+        if (nodes <= ZDD_NODES_SHOWN) {
+            std::cout << "\nСтруктура ДРНП (по 0 - без переменной, по 1 - с ней):\n";
+            printSeparator();
+            for (uint32_t id : zdd.levelOrder({family})) {
+                const BDDNode& node = zdd.node(id);
+                std::cout << "  [" << id << "] x" << (node.varIndex + 1)
+                          << " --0--> [" << node.low << "]"
+                          << ", --1--> [" << node.high << "]\n";
+            }
+            std::cout << "Корень: [" << family << "]\n";
         }
-        return nodes[current].value;
+
+        bool same = zdd.toMonomials(family) == getMonomials();
+        bool square = zdd.apply(ZDDOp::PRODUCT, family, family) == family;
+        std::cout << "\nМономы совпадают с полиномом: " << (same ? "да" : "НЕТ")
+                  << ", P·P = P: " << (square ? "да" : "НЕТ") << "\n";
+    }
+
+    // Полином в БДР и БДР в полином напрямую (см. anf_bdd.h); БДР строится
+    // в том же менеджере, поэтому совпадение проверяется сравнением корней
+    void displayDirectConversion() {
+        printHeader("ПОЛИНОМ ЖЕГАЛКИНА И БДР БЕЗ ТАБЛИЦЫ");
+
+        auto start = std::chrono::steady_clock::now();
+        uint32_t direct = ANFConverter::toBDD(manager, getMonomials());
+        double toBDDMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        std::vector<uint64_t> masks = ANFConverter::toMonomials(manager, root);
+        double toANFMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Мономов: " << getMonomials().size()
+                  << ", узлов БДР: " << manager.countNodes(root) << "\n";
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Полином -> БДР: " << toBDDMs << " мс, совпадает с БДР функции: "
+                  << (direct == root ? "да" : "НЕТ") << "\n";
+        std::cout << "БДР -> полином: " << toANFMs << " мс, совпадает с полиномом: "
+                  << (masks == getMonomials() ? "да" : "НЕТ") << "\n";
+
+        // промежуточные узлы разложения больше не нужны
+        compactNodes();
     }
 
     void interactiveEvaluateBDD() {
@@ -71,16 +247,17 @@ public:
         }
 
         std::cout << "\nПуть по БДР:\n";
-        int current = root;
-        while (nodes[current].varIndex != -1) {
-            int var = nodes[current].varIndex;
+        uint32_t current = root;
+        while (!manager.isTerminal(current)) {
+            const BDDNode& node = manager.node(current);
+            int var = node.varIndex;
             std::cout << "  x" << (var + 1) << " = " << input[var];
             if (input[var] == 0) {
-                std::cout << " --0--> [" << nodes[current].low << "]\n";
-                current = nodes[current].low;
+                std::cout << " --0--> [" << node.low << "]\n";
+                current = node.low;
             } else {
-                std::cout << " --1--> [" << nodes[current].high << "]\n";
-                current = nodes[current].high;
+                std::cout << " --1--> [" << node.high << "]\n";
+                current = node.high;
             }
         }
 
@@ -89,6 +266,6 @@ public:
             if (i > 0) std::cout << ", ";
             std::cout << input[i];
         }
-        std::cout << ") = " << nodes[current].value << "\n";
+        std::cout << ") = " << current << "\n";
     }
 };
@@ -0,0 +1,109 @@
+#pragma once
+#include "bdd_manager.h"
+
+// Функция в общем менеджере БДР: номер корня с внешней ссылкой.
+// Копирование добавляет ссылку, разрушение снимает её, поэтому узлы
+// функции переживают collectGarbage и перестановку переменных, пока жив
+// хотя бы один объект. Менеджер должен пережить все свои функции;
+// BDDManager::compact меняет номера узлов и с BDDFunction не совместим.
+class BDDFunction {
+private:
+    BDDManager* manager = nullptr;
+    uint32_t root = BDDManager::FALSE_NODE;
+
+    void checkSameManager(const BDDFunction& other) const {
+        if (manager != other.manager) {
+            throw std::invalid_argument("Функции из разных менеджеров БДР");
+        }
+    }
+
+    BDDFunction binary(BDDOp op, const BDDFunction& other) const {
+        checkSameManager(other);
+        return BDDFunction(*manager, manager->apply(op, root, other.root));
+    }
+
+public:
+    BDDFunction() = default;
+
+    BDDFunction(BDDManager& m, uint32_t f) : manager(&m), root(m.addRef(f)) {}
+
+    BDDFunction(const BDDFunction& other) : manager(other.manager), root(other.root) {
+        if (manager) manager->addRef(root);
+    }
+
+    BDDFunction(BDDFunction&& other) noexcept : manager(other.manager), root(other.root) {
+        other.manager = nullptr;
+    }
+
+    BDDFunction& operator=(BDDFunction other) noexcept {
+        std::swap(manager, other.manager);
+        std::swap(root, other.root);
+        return *this;
+    }
+
+    ~BDDFunction() {
+        if (manager) manager->release(root);
+    }
+
+    static BDDFunction constant(BDDManager& m, bool value) {
+        return BDDFunction(m, value ? BDDManager::TRUE_NODE : BDDManager::FALSE_NODE);
+    }
+
+    static BDDFunction variable(BDDManager& m, int var) {
+        return BDDFunction(m, m.variable(var));
+    }
+
+    BDDManager& getManager() const { return *manager; }
+    uint32_t getRoot() const { return root; }
+
+    bool isZero() const { return root == BDDManager::FALSE_NODE; }
+    bool isOne() const { return root == BDDManager::TRUE_NODE; }
+
+    // Номера узлов канонические: равенство функций - равенство корней
+    bool operator==(const BDDFunction& other) const {
+        return manager == other.manager && root == other.root;
+    }
+    bool operator!=(const BDDFunction& other) const { return !(*this == other); }
+
+    BDDFunction operator&(const BDDFunction& other) const { return binary(BDDOp::AND, other); }
+    BDDFunction operator|(const BDDFunction& other) const { return binary(BDDOp::OR, other); }
+    BDDFunction operator^(const BDDFunction& other) const { return binary(BDDOp::XOR, other); }
+    BDDFunction implies(const BDDFunction& other) const { return binary(BDDOp::IMPLIES, other); }
+    BDDFunction equiv(const BDDFunction& other) const { return binary(BDDOp::EQUIV, other); }
+
+    BDDFunction operator~() const {
+        return BDDFunction(*manager, manager->negate(root));
+    }
+
+    BDDFunction& operator&=(const BDDFunction& other) { return *this = *this & other; }
+    BDDFunction& operator|=(const BDDFunction& other) { return *this = *this | other; }
+    BDDFunction& operator^=(const BDDFunction& other) { return *this = *this ^ other; }
+
+    // f ? g : h
+    BDDFunction ite(const BDDFunction& g, const BDDFunction& h) const {
+        checkSameManager(g);
+        checkSameManager(h);
+        return BDDFunction(*manager, manager->ite(root, g.root, h.root));
+    }
+
+    BDDFunction restrict(int var, bool value) const {
+        return BDDFunction(*manager, manager->restrict(root, var, value));
+    }
+
+    BDDFunction exists(const std::vector<int>& vars) const {
+        return BDDFunction(*manager, manager->exists(root, vars));
+    }
+
+    BDDFunction forall(const std::vector<int>& vars) const {
+        return BDDFunction(*manager, manager->forall(root, vars));
+    }
+
+    BDDFunction compose(int var, const BDDFunction& g) const {
+        checkSameManager(g);
+        return BDDFunction(*manager, manager->compose(root, var, g.root));
+    }
+
+    size_t nodeCount() const {
+        return manager->countNodes(root);
+    }
+};
@@ -0,0 +1,310 @@
+#pragma once
+#include "bdd.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Запись БДР на языке DOT (Graphviz): узлы одного уровня в одном ряду,
+// ребро по 0 пунктиром, по 1 сплошной линией
+class BDDDot {
+public:
+    static void write(std::ostream& out, const BDDManager& manager, uint32_t root) {
+        std::vector<uint32_t> order = manager.levelOrder({root});
+
+        out << "digraph BDD {\n";
+        out << "  node [shape=circle];\n";
+        out << "  n0 [shape=box, label=\"0\"];\n";
+        out << "  n1 [shape=box, label=\"1\"];\n";
+        out << "  { rank=same; n0; n1; }\n";
+
+        size_t i = 0;
+        while (i < order.size()) {
+            int lvl = manager.level(order[i]);
+            out << "  { rank=same;";
+            for (size_t j = i; j < order.size() && manager.level(order[j]) == lvl; ++j) {
+                out << " n" << order[j] << ";";
+            }
+            out << " }\n";
+            for (; i < order.size() && manager.level(order[i]) == lvl; ++i) {
+                const BDDNode& node = manager.node(order[i]);
+                out << "  n" << order[i] << " [label=\"x" << (node.varIndex + 1) << "\"];\n";
+                out << "  n" << order[i] << " -> n" << node.low << " [style=dashed];\n";
+                out << "  n" << order[i] << " -> n" << node.high << ";\n";
+            }
+        }
+        out << "}\n";
+    }
+};
+
+// Двоичный формат компактной БДР (см. CompactBDD) в порядке байтов
+// машины: заголовок, переменные слоёв, границы слоёв, рёбра. Все поля
+// 32-битные и выровнены, поэтому отображённый в память файл вычисляется
+// прямо по рёбрам, без перестроения уникальной таблицы.
+struct BDDFileHeader {
+    static constexpr char MAGIC[4] = {'B', 'D', 'R', 'C'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[4];
+    uint32_t version;
+    uint32_t numVars;
+    uint32_t rootEdge;
+    uint32_t depth;
+    uint32_t nodeCount;  // вместе с листьями
+
+    static size_t fileSize(uint32_t numVars, uint32_t nodeCount) {
+        return sizeof(BDDFileHeader)
+             + (numVars + (numVars + 1) + 2 * static_cast<size_t>(nodeCount)) * sizeof(uint32_t);
+    }
+};
+
+// Компактная БДР из файла, отображённого в память только для чтения.
+// При открытии один проход проверяет то, что нужно для безопасного
+// обхода: номера в пределах файла, рёбра ведут в более глубокие слои или
+// в листья, биты наборов меньше числа переменных, глубина из заголовка
+// равна длине самого длинного пути. Страницы подгружаются системой по
+// мере обращения; один файл могут разделять несколько процессов.
+class MappedBDD {
+private:
+    void* data = MAP_FAILED;
+    size_t size = 0;
+    const BDDFileHeader* header = nullptr;
+    const int32_t* layerVars = nullptr;
+    const uint32_t* layerOffsets = nullptr;
+    const uint32_t* edges = nullptr;
+
+    void unmap() {
+        if (data != MAP_FAILED) munmap(data, size);
+        data = MAP_FAILED;
+    }
+
+    static void formatError() {
+        throw std::invalid_argument("Неверный формат файла БДР");
+    }
+
+    bool edgeValid(uint32_t edge, uint32_t minIndex) const {
+        uint32_t index = CompactBDD::edgeIndex(edge);
+        if (index < CompactBDD::FIRST_NODE) return edge == index;
+        return index >= minIndex && index < header->nodeCount
+            && CompactBDD::edgeShift(edge) < header->numVars;
+    }
+
+    void validate() const {
+        if (size < sizeof(BDDFileHeader)
+            || std::memcmp(header->magic, BDDFileHeader::MAGIC, sizeof(BDDFileHeader::MAGIC)) != 0
+            || header->version != BDDFileHeader::VERSION) {
+            formatError();
+        }
+        uint32_t n = header->numVars;
+        if (n > 64 || header->depth > n
+            || header->nodeCount < CompactBDD::FIRST_NODE
+            || header->nodeCount - CompactBDD::FIRST_NODE > CompactBDD::MAX_NODES
+            || size != BDDFileHeader::fileSize(n, header->nodeCount)) {
+            formatError();
+        }
+
+        if (edges[0] != CompactBDD::FALSE_EDGE || edges[1] != CompactBDD::FALSE_EDGE
+            || edges[2] != CompactBDD::TRUE_EDGE || edges[3] != CompactBDD::TRUE_EDGE
+            || layerOffsets[0] != 0 || layerOffsets[n] != header->nodeCount - CompactBDD::FIRST_NODE
+            || !edgeValid(header->rootEdge, CompactBDD::FIRST_NODE)) {
+            formatError();
+        }
+        // слои проходятся снизу вверх: рёбра ведут только в более глубокие
+        // слои, поэтому длины путей потомков уже известны. evaluate64 делает
+        // ровно depth шагов, так что depth обязан совпадать с самым длинным
+        // путём, иначе обход остановится на внутреннем узле
+        std::vector<uint32_t> pathLength(header->nodeCount, 0);
+        for (uint32_t lvl = n; lvl-- > 0;) {
+            if (layerOffsets[lvl] > layerOffsets[lvl + 1]
+                || layerVars[lvl] < 0 || static_cast<uint32_t>(layerVars[lvl]) >= n) {
+                formatError();
+            }
+            uint32_t next = layerOffsets[lvl + 1] + CompactBDD::FIRST_NODE;
+            for (uint32_t i = layerOffsets[lvl] + CompactBDD::FIRST_NODE; i < next; ++i) {
+                if (!edgeValid(edges[2 * i], next) || !edgeValid(edges[2 * i + 1], next)) {
+                    formatError();
+                }
+                pathLength[i] = 1 + std::max(pathLength[CompactBDD::edgeIndex(edges[2 * i])],
+                                             pathLength[CompactBDD::edgeIndex(edges[2 * i + 1])]);
+            }
+        }
+        if (pathLength[CompactBDD::edgeIndex(header->rootEdge)] != header->depth) {
+            formatError();
+        }
+    }
+
+public:
+    // Записать компактную БДР в формате BDDFileHeader
+    static void write(std::ostream& out, const CompactBDD& bdd) {
+        BDDFileHeader header;
+        std::memcpy(header.magic, BDDFileHeader::MAGIC, sizeof(header.magic));
+        header.version = BDDFileHeader::VERSION;
+        header.numVars = static_cast<uint32_t>(bdd.getNumVars());
+        header.rootEdge = bdd.getRootEdge();
+        header.depth = static_cast<uint32_t>(bdd.getDepth());
+        header.nodeCount = static_cast<uint32_t>(bdd.getEdges().size() / 2);
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::vector<int32_t> vars(bdd.getLayerVars().begin(), bdd.getLayerVars().end());
+        out.write(reinterpret_cast<const char*>(vars.data()), vars.size() * sizeof(int32_t));
+        const std::vector<uint32_t>& offsets = bdd.getLayerOffsets();
+        out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+        const std::vector<uint32_t>& edges = bdd.getEdges();
+        out.write(reinterpret_cast<const char*>(edges.data()), edges.size() * sizeof(uint32_t));
+        if (!out) {
+            throw std::runtime_error("Ошибка записи файла БДР");
+        }
+    }
+
+    explicit MappedBDD(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Не удалось открыть файл " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            size = static_cast<size_t>(info.st_size);
+            data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Не удалось отобразить в память файл " + path);
+        }
+
+        const char* bytes = static_cast<const char*>(data);
+        header = reinterpret_cast<const BDDFileHeader*>(bytes);
+        if (size >= sizeof(BDDFileHeader) && header->numVars <= 64) {
+            layerVars = reinterpret_cast<const int32_t*>(bytes + sizeof(BDDFileHeader));
+            layerOffsets = reinterpret_cast<const uint32_t*>(layerVars + header->numVars);
+            edges = layerOffsets + header->numVars + 1;
+        }
+        try {
+            validate();
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    ~MappedBDD() { unmap(); }
+
+    MappedBDD(const MappedBDD&) = delete;
+    MappedBDD& operator=(const MappedBDD&) = delete;
+
+    int getNumVars() const { return static_cast<int>(header->numVars); }
+    size_t nodeCount() const { return header->nodeCount - CompactBDD::FIRST_NODE; }
+    size_t fileBytes() const { return size; }
+
+    // переменная слоя lvl
+    int layerVar(int lvl) const { return layerVars[lvl]; }
+
+    CompactBDDView view() const {
+        return {getNumVars(), header->rootEdge, static_cast<int>(header->depth), edges};
+    }
+
+    int evaluate(uint64_t input) const { return view().evaluate(input); }
+
+    uint64_t evaluate64(const uint64_t* inputs, size_t count) const {
+        return view().evaluate64(inputs, count);
+    }
+
+    BitTable toBitTable() const { return view().toBitTable(); }
+};
+
+// Сохранение текущей БДР в DOT или двоичный файл и загрузка двоичного
+class BDDFileUI : public CliUI {
+private:
+    static constexpr int MAX_TABLE_VARS = 24;
+    static constexpr size_t BENCHMARK_INPUTS = 1 << 20;
+
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    std::string readPath() const {
+        std::cout << "Путь к файлу: ";
+        std::string path;
+        std::cin.ignore(10000, '\n');
+        std::getline(std::cin, path);
+        return path;
+    }
+
+    void load(BDD& func, const std::string& path) {
+        Clock::time_point start = Clock::now();
+        MappedBDD mapped(path);
+        double ms = elapsedMs(start);
+
+        int n = mapped.getNumVars();
+        std::cout << "Переменных: " << n << ", узлов: " << mapped.nodeCount()
+                  << ", байт: " << mapped.fileBytes() << "\n";
+        std::cout << "Порядок:";
+        for (int lvl = 0; lvl < n; ++lvl) {
+            std::cout << " x" << (mapped.layerVar(lvl) + 1);
+        }
+        std::cout << "\nОтображение и проверка: " << std::fixed << std::setprecision(3) << ms << " мс\n";
+
+        std::mt19937_64 rng(std::random_device{}());
+        uint64_t inputs[64];
+        size_t ones = 0;
+        start = Clock::now();
+        for (size_t done = 0; done < BENCHMARK_INPUTS; done += 64) {
+            for (uint64_t& input : inputs) input = rng();
+            ones += __builtin_popcountll(mapped.evaluate64(inputs, 64));
+        }
+        ms = elapsedMs(start);
+        std::cout << "Вычисление на " << BENCHMARK_INPUTS << " случайных наборах: "
+                  << std::setprecision(1) << (ms > 0.0 ? BENCHMARK_INPUTS / (ms * 1000.0) : 0.0)
+                  << " млн наборов/с, единиц: " << ones << "\n";
+
+        if (n == 0 || n > MAX_TABLE_VARS) {
+            std::cout << "Текущая функция не изменена (таблица истинности строится для 1.."
+                      << MAX_TABLE_VARS << " входов)\n";
+            return;
+        }
+        func = BDD(mapped.toBitTable());
+        std::cout << "Функция загружена как текущая\n";
+    }
+
+public:
+    void interactiveRun(BDD& func) {
+        printHeader("ЭКСПОРТ И ЗАГРУЗКА БДР");
+
+        std::cout << "1. Сохранить в DOT (Graphviz)\n";
+        std::cout << "2. Сохранить в двоичный файл\n";
+        std::cout << "3. Загрузить двоичный файл\n";
+        int mode = getUserInput("Действие: ", 1, 3);
+        std::string path = readPath();
+
+        try {
+            if (mode == 3) {
+                load(func, path);
+                return;
+            }
+
+            std::ofstream file(path, mode == 1 ? std::ios::out : std::ios::out | std::ios::binary);
+            if (!file) {
+                std::cout << "Не удалось открыть файл " << path << "\n";
+                return;
+            }
+            if (mode == 1) {
+                BDDDot::write(file, func.getManager(), func.getRoot());
+            } else {
+                MappedBDD::write(file, func.toCompact());
+            }
+            file.close();
+            if (!file) {
+                throw std::runtime_error("Ошибка записи файла " + path);
+            }
+            std::cout << "БДР сохранена в " << path << "\n";
+        } catch (const std::exception& e) {
+            std::cout << "Ошибка: " << e.what() << "\n";
+        }
+    }
+};
@@ -0,0 +1,940 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include "bit_table.h"
+
+// Бинарные операции для apply
+enum class BDDOp {
+    AND,
+    OR,
+    XOR,
+    IMPLIES,
+    EQUIV,
+};
+
+// Методы перестановки переменных
+enum class ReorderMethod {
+    NONE,
+    SIFTING,  // просеивание Рудела
+    WINDOW,   // перебор перестановок в окне из трёх соседних уровней
+};
+
+// Итог одной перестановки
+struct ReorderStats {
+    size_t nodesBefore = 0;
+    size_t nodesAfter = 0;
+    size_t swaps = 0;
+    double timeMs = 0.0;
+};
+
+struct BDDNode {
+    int varIndex;   // -1 для листа и свободного узла
+    uint32_t low;   // потомок по 0
+    uint32_t high;  // потомок по 1
+    uint32_t next;  // следующий узел в цепочке уникальной таблицы
+};
+
+// Менеджер сокращённых упорядоченных БДР (ROBDD).
+// Узлы хранятся в общем массиве, листы - узлы 0 и 1. Уникальная таблица
+// (отдельная хеш-таблица с цепочками на каждую переменную) гарантирует,
+// что каждая тройка (x, low, high) существует в одном экземпляре, поэтому
+// равные функции имеют один и тот же номер узла. Результаты ite, apply,
+// отрицания, ограничения, квантификации и композиции кешируются в общей
+// таблице вычислений с прямым отображением.
+//
+// Для перестановки переменных у каждого узла есть счётчик ссылок: число
+// родителей плюс внешние ссылки (addRef/release). Перестановка меняет местами
+// соседние уровни на месте, поэтому номера живых узлов и их функции
+// сохраняются; узлы без ссылок перед перестановкой освобождаются, и их
+// номера повторно используются в mk.
+//
+// Один менеджер может хранить сколько угодно функций: общие подграфы
+// существуют в одном экземпляре, а удерживать корни удобно через
+// BDDFunction (bdd_function.h), который сам вызывает addRef/release.
+class BDDManager {
+public:
+    static constexpr uint32_t FALSE_NODE = 0;
+    static constexpr uint32_t TRUE_NODE = 1;
+
+protected:
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+    static constexpr size_t MIN_CACHE_SIZE = 1 << 16;
+    static constexpr size_t MAX_CACHE_SIZE = 1 << 22;
+    static constexpr size_t AUTO_REORDER_THRESHOLD = 1 << 12;
+    static constexpr double MAX_SIFT_GROWTH = 1.2;
+
+    struct CacheEntry {
+        uint32_t op;
+        uint32_t a, b, c;
+        uint32_t result;
+    };
+
+    enum CacheOp : uint32_t {
+        OP_NONE = 0,
+        OP_ITE = 1,
+        OP_NOT = 2,
+        OP_RESTRICT = 3,
+        OP_EXISTS = 4,
+        OP_FORALL = 5,
+        OP_COMPOSE = 6,
+        OP_APPLY = 16,  // OP_APPLY + BDDOp
+        OP_ZDD = 32,    // OP_ZDD + ZDDOp (zdd.h)
+    };
+
+    int numVars;
+    std::vector<BDDNode> nodes;
+
+    std::vector<int> var2level;
+    std::vector<int> level2var;
+
+    std::vector<std::vector<uint32_t>> buckets;  // по переменным
+    std::vector<size_t> levelCounts;             // узлов на переменную
+
+    std::vector<uint32_t> refs;
+    std::vector<uint32_t> freeNodes;
+
+    ReorderMethod autoMethod = ReorderMethod::NONE;
+    size_t autoThreshold = AUTO_REORDER_THRESHOLD;
+    ReorderStats lastReorder;
+
+    std::vector<CacheEntry> cache;
+    uint64_t cacheLookups = 0;
+    uint64_t cacheHits = 0;
+
+    static uint64_t hash3(uint64_t a, uint64_t b, uint64_t c) {
+        uint64_t h = a * 0x9E3779B97F4A7C15ULL;
+        h ^= b + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+        h ^= c * 0xC2B2AE3D27D4EB4FULL + (h << 6) + (h >> 2);
+        return h ^ (h >> 31);
+    }
+
+    size_t bucketIndex(int var, uint32_t low, uint32_t high) const {
+        return hash3(static_cast<uint64_t>(var), low, high) & (buckets[var].size() - 1);
+    }
+
+    void growBuckets(int var) {
+        std::vector<uint32_t> old(buckets[var].size() * 2, NO_NODE);
+        old.swap(buckets[var]);
+
+        for (uint32_t head : old) {
+            while (head != NO_NODE) {
+                uint32_t next = nodes[head].next;
+                size_t index = bucketIndex(var, nodes[head].low, nodes[head].high);
+                nodes[head].next = buckets[var][index];
+                buckets[var][index] = head;
+                head = next;
+            }
+        }
+    }
+
+    void linkNode(uint32_t f) {
+        int var = nodes[f].varIndex;
+        size_t index = bucketIndex(var, nodes[f].low, nodes[f].high);
+        nodes[f].next = buckets[var][index];
+        buckets[var][index] = f;
+
+        if (++levelCounts[var] > buckets[var].size()) {
+            growBuckets(var);
+        }
+    }
+
+    void unlinkNode(uint32_t f) {
+        int var = nodes[f].varIndex;
+        uint32_t* link = &buckets[var][bucketIndex(var, nodes[f].low, nodes[f].high)];
+        while (*link != f) {
+            link = &nodes[*link].next;
+        }
+        *link = nodes[f].next;
+        --levelCounts[var];
+    }
+
+    // Снять ссылку; узел без ссылок сразу освобождается вместе с потомками
+    void derefNode(uint32_t f) {
+        if (isTerminal(f) || --refs[f] > 0) {
+            return;
+        }
+        freeNode(f);
+    }
+
+    void freeNode(uint32_t f) {
+        unlinkNode(f);
+        uint32_t low = nodes[f].low, high = nodes[f].high;
+        nodes[f] = {-1, FALSE_NODE, FALSE_NODE, NO_NODE};
+        freeNodes.push_back(f);
+
+        derefNode(low);
+        derefNode(high);
+    }
+
+    // Узлы с внешними ссылками: счётчик больше числа родителей
+    std::vector<uint32_t> externalRoots() const {
+        std::vector<uint32_t> parents(nodes.size(), 0);
+        for (uint32_t f = 2; f < nodes.size(); ++f) {
+            if (nodes[f].varIndex < 0) continue;
+            ++parents[nodes[f].low];
+            ++parents[nodes[f].high];
+        }
+
+        std::vector<uint32_t> roots;
+        for (uint32_t f = 2; f < nodes.size(); ++f) {
+            if (nodes[f].varIndex >= 0 && refs[f] > parents[f]) {
+                roots.push_back(f);
+            }
+        }
+        return roots;
+    }
+
+    void checkVar(int var) const {
+        if (var < 0 || var >= numVars) {
+            throw std::out_of_range("Номер переменной вне диапазона");
+        }
+    }
+
+    void clearCache() {
+        std::fill(cache.begin(), cache.end(), CacheEntry{OP_NONE, 0, 0, 0, 0});
+    }
+
+    // Обмен переменных на уровнях lvl и lvl + 1. Узел x с потомками,
+    // зависящими от y, перестраивается на месте в узел y, так что его номер
+    // по-прежнему обозначает ту же функцию.
+    void swapLevels(int lvl) {
+        int x = level2var[lvl];
+        int y = level2var[lvl + 1];
+
+        std::vector<uint32_t> xNodes;
+        xNodes.reserve(levelCounts[x]);
+        for (uint32_t head : buckets[x]) {
+            for (uint32_t f = head; f != NO_NODE; f = nodes[f].next) {
+                xNodes.push_back(f);
+            }
+        }
+
+        level2var[lvl] = y;
+        level2var[lvl + 1] = x;
+        var2level[x] = lvl + 1;
+        var2level[y] = lvl;
+
+        for (uint32_t f : xNodes) {
+            uint32_t f0 = nodes[f].low, f1 = nodes[f].high;
+            bool y0 = !isTerminal(f0) && nodes[f0].varIndex == y;
+            bool y1 = !isTerminal(f1) && nodes[f1].varIndex == y;
+            if (!y0 && !y1) {
+                continue;
+            }
+
+            uint32_t f00 = y0 ? nodes[f0].low : f0;
+            uint32_t f01 = y0 ? nodes[f0].high : f0;
+            uint32_t f10 = y1 ? nodes[f1].low : f1;
+            uint32_t f11 = y1 ? nodes[f1].high : f1;
+
+            unlinkNode(f);
+            uint32_t low = mk(x, f00, f10);
+            ++refs[low];
+            uint32_t high = mk(x, f01, f11);
+            ++refs[high];
+
+            nodes[f].varIndex = y;
+            nodes[f].low = low;
+            nodes[f].high = high;
+            linkNode(f);
+
+            derefNode(f0);
+            derefNode(f1);
+        }
+
+        ++lastReorder.swaps;
+    }
+
+    // Переместить переменную с уровня from на уровень to соседними обменами
+    void moveLevel(int from, int to) {
+        for (; from > to; --from) swapLevels(from - 1);
+        for (; from < to; ++from) swapLevels(from);
+    }
+
+    void siftVariable(int var) {
+        int lvl = var2level[var];
+        size_t best = liveNodes();
+        int bestLevel = lvl;
+
+        auto step = [&](int target) {
+            while (lvl != target) {
+                int next = lvl < target ? lvl + 1 : lvl - 1;
+                moveLevel(lvl, next);
+                lvl = next;
+
+                size_t size = liveNodes();
+                if (size < best) {
+                    best = size;
+                    bestLevel = lvl;
+                }
+                if (size > best * MAX_SIFT_GROWTH) {
+                    break;
+                }
+            }
+        };
+
+        // сначала к ближнему краю, затем к дальнему
+        if (lvl < numVars - 1 - lvl) {
+            step(0);
+            step(numVars - 1);
+        } else {
+            step(numVars - 1);
+            step(0);
+        }
+        moveLevel(lvl, bestLevel);
+    }
+
+    void sift() {
+        std::vector<int> vars(numVars);
+        for (int i = 0; i < numVars; ++i) vars[i] = i;
+        std::sort(vars.begin(), vars.end(), [this](int a, int b) {
+            return levelCounts[a] > levelCounts[b];
+        });
+
+        for (int var : vars) {
+            siftVariable(var);
+        }
+    }
+
+    // Все 3! перестановок уровней lvl..lvl+2 обходятся пятью обменами
+    bool permuteWindow(int lvl) {
+        const int sequence[5] = {0, 1, 0, 1, 0};
+        size_t best = liveNodes();
+        int bestStep = 0;
+
+        for (int i = 0; i < 5; ++i) {
+            swapLevels(lvl + sequence[i]);
+            if (liveNodes() < best) {
+                best = liveNodes();
+                bestStep = i + 1;
+            }
+        }
+
+        // шестой обмен возвращает исходный порядок
+        swapLevels(lvl + 1);
+        for (int i = 0; i < bestStep; ++i) {
+            swapLevels(lvl + sequence[i]);
+        }
+        return bestStep != 0;
+    }
+
+    void windowPermute() {
+        if (numVars == 2) {
+            size_t before = liveNodes();
+            swapLevels(0);
+            if (liveNodes() >= before) swapLevels(0);
+            return;
+        }
+
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (int lvl = 0; lvl + 2 < numVars; ++lvl) {
+                improved |= permuteWindow(lvl);
+            }
+        }
+    }
+
+    bool cacheLookup(uint32_t op, uint32_t a, uint32_t b, uint32_t c, uint32_t& result) {
+        ++cacheLookups;
+        const CacheEntry& entry = cache[hash3(a ^ (uint64_t(op) << 32), b, c) & (cache.size() - 1)];
+        if (entry.op == op && entry.a == a && entry.b == b && entry.c == c) {
+            ++cacheHits;
+            result = entry.result;
+            return true;
+        }
+        return false;
+    }
+
+    void cacheInsert(uint32_t op, uint32_t a, uint32_t b, uint32_t c, uint32_t result) {
+        cache[hash3(a ^ (uint64_t(op) << 32), b, c) & (cache.size() - 1)] = {op, a, b, c, result};
+    }
+
+    void growCacheIfNeeded() {
+        if (nodes.size() > cache.size() && cache.size() < MAX_CACHE_SIZE) {
+            cache.assign(cache.size() * 2, CacheEntry{OP_NONE, 0, 0, 0, 0});
+        }
+    }
+
+    int topLevel(uint32_t f, uint32_t g, uint32_t h) const {
+        return std::min(level(f), std::min(level(g), level(h)));
+    }
+
+    uint32_t cofactor(uint32_t f, int lvl, bool positive) const {
+        if (level(f) != lvl) return f;
+        return positive ? nodes[f].high : nodes[f].low;
+    }
+
+    // Результат apply, если он определяется без рекурсии, иначе NO_NODE;
+    // negate - отрицание, которым пользуется вызывающий
+    template<typename Negate>
+    static uint32_t applyTerminal(BDDOp op, uint32_t f, uint32_t g, Negate negate) {
+        switch (op) {
+            case BDDOp::AND:
+                if (f == FALSE_NODE || g == FALSE_NODE) return FALSE_NODE;
+                if (f == TRUE_NODE || f == g) return g;
+                if (g == TRUE_NODE) return f;
+                break;
+            case BDDOp::OR:
+                if (f == TRUE_NODE || g == TRUE_NODE) return TRUE_NODE;
+                if (f == FALSE_NODE || f == g) return g;
+                if (g == FALSE_NODE) return f;
+                break;
+            case BDDOp::XOR:
+                if (f == g) return FALSE_NODE;
+                if (f == FALSE_NODE) return g;
+                if (g == FALSE_NODE) return f;
+                if (f == TRUE_NODE) return negate(g);
+                if (g == TRUE_NODE) return negate(f);
+                break;
+            case BDDOp::IMPLIES:
+                if (f == FALSE_NODE || g == TRUE_NODE || f == g) return TRUE_NODE;
+                if (f == TRUE_NODE) return g;
+                if (g == FALSE_NODE) return negate(f);
+                break;
+            case BDDOp::EQUIV:
+                if (f == g) return TRUE_NODE;
+                if (f == TRUE_NODE) return g;
+                if (g == TRUE_NODE) return f;
+                if (f == FALSE_NODE) return negate(g);
+                if (g == FALSE_NODE) return negate(f);
+                break;
+        }
+        return NO_NODE;
+    }
+
+    static bool isCommutative(BDDOp op) {
+        return op != BDDOp::IMPLIES;
+    }
+
+    uint32_t quantify(uint32_t f, uint32_t cube, bool existential) {
+        if (isTerminal(f) || cube == TRUE_NODE) {
+            return f;
+        }
+
+        // переменные квантора выше f на неё не влияют
+        while (cube != TRUE_NODE && level(cube) < level(f)) {
+            cube = nodes[cube].high;
+        }
+        if (cube == TRUE_NODE) {
+            return f;
+        }
+
+        uint32_t op = existential ? OP_EXISTS : OP_FORALL;
+        uint32_t result;
+        if (cacheLookup(op, f, cube, 0, result)) {
+            return result;
+        }
+
+        const BDDNode& node = nodes[f];
+        int var = node.varIndex;
+        uint32_t fLow = node.low, fHigh = node.high;
+
+        if (level(cube) == level(f)) {
+            uint32_t rest = nodes[cube].high;
+            uint32_t low = quantify(fLow, rest, existential);
+            uint32_t high = quantify(fHigh, rest, existential);
+            result = apply(existential ? BDDOp::OR : BDDOp::AND, low, high);
+        } else {
+            uint32_t low = quantify(fLow, cube, existential);
+            uint32_t high = quantify(fHigh, cube, existential);
+            result = mk(var, low, high);
+        }
+
+        cacheInsert(op, f, cube, 0, result);
+        return result;
+    }
+
+    uint32_t buildFromValues(const BitTable& values, int lvl, size_t index) {
+        if (lvl == numVars) {
+            return values.get(index) ? TRUE_NODE : FALSE_NODE;
+        }
+
+        int var = level2var[lvl];
+        size_t bit = size_t(1) << (numVars - 1 - var);
+
+        uint32_t low = buildFromValues(values, lvl + 1, index);
+        uint32_t high = buildFromValues(values, lvl + 1, index | bit);
+        return mk(var, low, high);
+    }
+
+    // Найти или создать узел (var, low, high) без правил сокращения;
+    // правило выбирает вызывающий (mk здесь, ZDDManager::mkZero в zdd.h)
+    uint32_t findOrAdd(int var, uint32_t low, uint32_t high) {
+        size_t index = bucketIndex(var, low, high);
+        for (uint32_t f = buckets[var][index]; f != NO_NODE; f = nodes[f].next) {
+            if (nodes[f].low == low && nodes[f].high == high) {
+                return f;
+            }
+        }
+
+        uint32_t f;
+        if (!freeNodes.empty()) {
+            f = freeNodes.back();
+            freeNodes.pop_back();
+            nodes[f] = {var, low, high, NO_NODE};
+            refs[f] = 0;
+        } else {
+            if (nodes.size() >= NO_NODE) {
+                throw std::length_error("Превышено максимальное число узлов БДР");
+            }
+            f = static_cast<uint32_t>(nodes.size());
+            nodes.push_back({var, low, high, NO_NODE});
+            refs.push_back(0);
+        }
+
+        ++refs[low];
+        ++refs[high];
+        linkNode(f);
+        growCacheIfNeeded();
+
+        return f;
+    }
+
+public:
+    explicit BDDManager(int n) : numVars(n) {
+        if (n < 0) {
+            throw std::invalid_argument("Число переменных должно быть неотрицательным");
+        }
+
+        nodes.push_back({-1, FALSE_NODE, FALSE_NODE, NO_NODE});
+        nodes.push_back({-1, TRUE_NODE, TRUE_NODE, NO_NODE});
+
+        var2level.resize(n);
+        level2var.resize(n);
+        for (int i = 0; i < n; ++i) {
+            var2level[i] = i;
+            level2var[i] = i;
+        }
+
+        buckets.assign(n, std::vector<uint32_t>(16, NO_NODE));
+        levelCounts.assign(n, 0);
+        refs.assign(2, 0);
+        cache.assign(MIN_CACHE_SIZE, CacheEntry{OP_NONE, 0, 0, 0, 0});
+    }
+
+    int getNumVars() const { return numVars; }
+
+    bool isTerminal(uint32_t f) const { return f <= TRUE_NODE; }
+
+    const BDDNode& node(uint32_t f) const { return nodes[f]; }
+
+    int level(uint32_t f) const {
+        return isTerminal(f) ? numVars : var2level[nodes[f].varIndex];
+    }
+
+    const std::vector<int>& getOrder() const { return level2var; }
+
+    // Найти или создать узел (var, low, high) с правилом сокращения low == high
+    uint32_t mk(int var, uint32_t low, uint32_t high) {
+        if (low == high) {
+            return low;
+        }
+        return findOrAdd(var, low, high);
+    }
+
+    uint32_t variable(int var) {
+        checkVar(var);
+        return mk(var, FALSE_NODE, TRUE_NODE);
+    }
+
+    // if-then-else: f ? g : h
+    uint32_t ite(uint32_t f, uint32_t g, uint32_t h) {
+        if (f == TRUE_NODE) return g;
+        if (f == FALSE_NODE) return h;
+        if (g == h) return g;
+        if (g == TRUE_NODE && h == FALSE_NODE) return f;
+
+        uint32_t result;
+        if (cacheLookup(OP_ITE, f, g, h, result)) {
+            return result;
+        }
+
+        int lvl = topLevel(f, g, h);
+        int var = level2var[lvl];
+
+        uint32_t low = ite(cofactor(f, lvl, false), cofactor(g, lvl, false), cofactor(h, lvl, false));
+        uint32_t high = ite(cofactor(f, lvl, true), cofactor(g, lvl, true), cofactor(h, lvl, true));
+        result = mk(var, low, high);
+
+        cacheInsert(OP_ITE, f, g, h, result);
+        return result;
+    }
+
+    uint32_t apply(BDDOp op, uint32_t f, uint32_t g) {
+        uint32_t result = applyTerminal(op, f, g, [this](uint32_t x) { return negate(x); });
+        if (result != NO_NODE) {
+            return result;
+        }
+
+        if (isCommutative(op) && f > g) {
+            std::swap(f, g);
+        }
+
+        uint32_t code = OP_APPLY + static_cast<uint32_t>(op);
+        if (cacheLookup(code, f, g, 0, result)) {
+            return result;
+        }
+
+        int lvl = std::min(level(f), level(g));
+        int var = level2var[lvl];
+
+        uint32_t low = apply(op, cofactor(f, lvl, false), cofactor(g, lvl, false));
+        uint32_t high = apply(op, cofactor(f, lvl, true), cofactor(g, lvl, true));
+        result = mk(var, low, high);
+
+        cacheInsert(code, f, g, 0, result);
+        return result;
+    }
+
+    uint32_t negate(uint32_t f) {
+        if (isTerminal(f)) {
+            return f ^ 1;
+        }
+
+        uint32_t result;
+        if (cacheLookup(OP_NOT, f, 0, 0, result)) {
+            return result;
+        }
+
+        int var = nodes[f].varIndex;
+        uint32_t low = negate(nodes[f].low);
+        uint32_t high = negate(nodes[f].high);
+        result = mk(var, low, high);
+
+        cacheInsert(OP_NOT, f, 0, 0, result);
+        return result;
+    }
+
+    // Кофактор f по x_var = value
+    uint32_t restrict(uint32_t f, int var, bool value) {
+        checkVar(var);
+        if (isTerminal(f) || level(f) > var2level[var]) {
+            return f;
+        }
+
+        const BDDNode& node = nodes[f];
+        if (node.varIndex == var) {
+            return value ? node.high : node.low;
+        }
+
+        uint32_t key = static_cast<uint32_t>(var) * 2 + (value ? 1 : 0);
+        uint32_t result;
+        if (cacheLookup(OP_RESTRICT, f, key, 0, result)) {
+            return result;
+        }
+
+        int nodeVar = node.varIndex;
+        uint32_t fLow = node.low, fHigh = node.high;
+        uint32_t low = restrict(fLow, var, value);
+        uint32_t high = restrict(fHigh, var, value);
+        result = mk(nodeVar, low, high);
+
+        cacheInsert(OP_RESTRICT, f, key, 0, result);
+        return result;
+    }
+
+    // Конъюнкция переменных - представление множества переменных для кванторов
+    uint32_t cube(const std::vector<int>& vars) {
+        for (int var : vars) {
+            checkVar(var);
+        }
+        std::vector<int> sorted = vars;
+        std::sort(sorted.begin(), sorted.end(), [this](int a, int b) {
+            return var2level[a] > var2level[b];
+        });
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        uint32_t result = TRUE_NODE;
+        for (int var : sorted) {
+            result = mk(var, FALSE_NODE, result);
+        }
+        return result;
+    }
+
+    // Куб в нумерации битов строк таблицы истинности: бит (n - 1 - j) в care
+    // означает литерал x(j+1), его знак - тот же бит value
+    uint32_t cube(uint64_t value, uint64_t care) {
+        if (numVars > 64) {
+            throw std::invalid_argument("Куб по маске задаётся не более чем для 64 переменных");
+        }
+        std::vector<int> vars;
+        for (int var = 0; var < numVars; ++var) {
+            if ((care >> (numVars - 1 - var)) & 1) vars.push_back(var);
+        }
+        std::sort(vars.begin(), vars.end(), [this](int a, int b) {
+            return var2level[a] > var2level[b];
+        });
+
+        uint32_t result = TRUE_NODE;
+        for (int var : vars) {
+            if ((value >> (numVars - 1 - var)) & 1) {
+                result = mk(var, FALSE_NODE, result);
+            } else {
+                result = mk(var, result, FALSE_NODE);
+            }
+        }
+        return result;
+    }
+
+    uint32_t exists(uint32_t f, const std::vector<int>& vars) {
+        return quantify(f, cube(vars), true);
+    }
+
+    uint32_t forall(uint32_t f, const std::vector<int>& vars) {
+        return quantify(f, cube(vars), false);
+    }
+
+    // Подстановка функции g вместо переменной x_var: f[x_var := g]
+    uint32_t compose(uint32_t f, int var, uint32_t g) {
+        checkVar(var);
+        if (isTerminal(f) || level(f) > var2level[var]) {
+            return f;
+        }
+
+        const BDDNode& node = nodes[f];
+        if (node.varIndex == var) {
+            uint32_t fLow = node.low, fHigh = node.high;
+            return ite(g, fHigh, fLow);
+        }
+
+        uint32_t result;
+        if (cacheLookup(OP_COMPOSE, f, static_cast<uint32_t>(var), g, result)) {
+            return result;
+        }
+
+        int nodeVar = node.varIndex;
+        uint32_t fLow = node.low, fHigh = node.high;
+        uint32_t low = compose(fLow, var, g);
+        uint32_t high = compose(fHigh, var, g);
+        result = ite(variable(nodeVar), high, low);
+
+        cacheInsert(OP_COMPOSE, f, static_cast<uint32_t>(var), g, result);
+        return result;
+    }
+
+    // Построение по вектору значений: строка i, старший бит индекса - x1
+    uint32_t fromTruthTable(const BitTable& table) {
+        if (table.getNumVars() != numVars) {
+            throw std::invalid_argument("Размер таблицы истинности не равен 2^n");
+        }
+        return buildFromValues(table, 0, 0);
+    }
+
+    uint32_t fromTruthTable(const std::vector<int>& values) {
+        if (numVars > BitTable::MAX_VARS) {
+            throw std::invalid_argument("Размер таблицы истинности не равен 2^n");
+        }
+        return fromTruthTable(BitTable::fromValues(numVars, values));
+    }
+
+    int evaluate(uint32_t f, const std::vector<int>& input) const {
+        while (!isTerminal(f)) {
+            f = input[nodes[f].varIndex] ? nodes[f].high : nodes[f].low;
+        }
+        return static_cast<int>(f);
+    }
+
+    // Узлы, достижимые из корня (включая листья), по возрастанию уровня
+    std::vector<uint32_t> reachableNodes(uint32_t root) const {
+        std::vector<uint32_t> result;
+        std::vector<char> seen(nodes.size(), 0);
+        std::vector<uint32_t> stack = {root};
+
+        while (!stack.empty()) {
+            uint32_t f = stack.back();
+            stack.pop_back();
+            if (seen[f]) continue;
+            seen[f] = 1;
+            result.push_back(f);
+
+            if (!isTerminal(f)) {
+                stack.push_back(nodes[f].low);
+                stack.push_back(nodes[f].high);
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [this](uint32_t a, uint32_t b) {
+            return level(a) != level(b) ? level(a) < level(b) : a < b;
+        });
+        return result;
+    }
+
+    size_t countNodes(uint32_t root) const {
+        return reachableNodes(root).size();
+    }
+
+    // Узлы, общие для нескольких функций, считаются один раз (с листьями)
+    size_t countNodes(const std::vector<uint32_t>& roots) const {
+        return levelOrder(roots).size() + 2;
+    }
+
+    // Узлы в уникальных таблицах вместе с листьями
+    size_t liveNodes() const {
+        size_t total = 2;
+        for (size_t count : levelCounts) total += count;
+        return total;
+    }
+
+    size_t totalNodes() const { return liveNodes(); }
+
+    // Внешние ссылки: только удерживаемые ими узлы переживают
+    // сборку мусора и перестановку переменных
+    uint32_t addRef(uint32_t f) {
+        if (!isTerminal(f)) ++refs[f];
+        return f;
+    }
+
+    void release(uint32_t f) {
+        if (!isTerminal(f) && refs[f] > 0) --refs[f];
+    }
+
+    // Нетерминальные узлы, достижимые из roots, в порядке обхода в ширину
+    // по уровням: уровень за уровнем сверху вниз, внутри уровня - в порядке
+    // первого обращения из вышележащих уровней (корни уровня идут первыми)
+    std::vector<uint32_t> levelOrder(const std::vector<uint32_t>& roots) const {
+        std::vector<std::vector<uint32_t>> byLevel(numVars);
+        std::vector<char> seen(nodes.size(), 0);
+
+        auto visit = [&](uint32_t f) {
+            if (isTerminal(f) || seen[f]) return;
+            seen[f] = 1;
+            byLevel[level(f)].push_back(f);
+        };
+
+        for (uint32_t f : roots) {
+            visit(f);
+        }
+
+        std::vector<uint32_t> order;
+        for (int lvl = 0; lvl < numVars; ++lvl) {
+            for (uint32_t f : byLevel[lvl]) {
+                order.push_back(f);
+                visit(nodes[f].low);
+                visit(nodes[f].high);
+            }
+        }
+        return order;
+    }
+
+    // Сборка мусора и перенумерация живых узлов в порядке levelOrder от
+    // узлов с внешними ссылками, чтобы обходы шли по соседним ячейкам памяти.
+    // Возвращает отображение старых номеров в новые (NO_NODE - освобождён);
+    // удерживаемые снаружи номера нужно пересчитать через него.
+    std::vector<uint32_t> compact() {
+        collectGarbage();
+
+        std::vector<uint32_t> order = levelOrder(externalRoots());
+        std::vector<uint32_t> remap(nodes.size(), NO_NODE);
+        remap[FALSE_NODE] = FALSE_NODE;
+        remap[TRUE_NODE] = TRUE_NODE;
+        for (size_t i = 0; i < order.size(); ++i) {
+            remap[order[i]] = static_cast<uint32_t>(i + 2);
+        }
+
+        std::vector<BDDNode> oldNodes;
+        std::vector<uint32_t> oldRefs;
+        oldNodes.swap(nodes);
+        oldRefs.swap(refs);
+
+        nodes.assign(oldNodes.begin(), oldNodes.begin() + 2);
+        refs.assign(oldRefs.begin(), oldRefs.begin() + 2);
+        for (uint32_t f : order) {
+            const BDDNode& node = oldNodes[f];
+            nodes.push_back({node.varIndex, remap[node.low], remap[node.high], NO_NODE});
+            refs.push_back(oldRefs[f]);
+        }
+
+        freeNodes.clear();
+        for (int var = 0; var < numVars; ++var) {
+            std::fill(buckets[var].begin(), buckets[var].end(), NO_NODE);
+            levelCounts[var] = 0;
+        }
+        for (uint32_t f = 2; f < nodes.size(); ++f) {
+            linkNode(f);
+        }
+
+        clearCache();
+        return remap;
+    }
+
+    // Пометка и очистка: помечаются узлы, достижимые из удерживаемых
+    // снаружи корней, остальные освобождаются за один линейный проход без
+    // рекурсии; счётчики ссылок выживших уменьшаются на число мёртвых
+    // родителей. Возвращает число освобождённых узлов.
+    size_t collectGarbage() {
+        size_t before = liveNodes();
+
+        std::vector<char> marked(nodes.size(), 0);
+        std::vector<uint32_t> stack = externalRoots();
+        while (!stack.empty()) {
+            uint32_t f = stack.back();
+            stack.pop_back();
+            if (isTerminal(f) || marked[f]) continue;
+            marked[f] = 1;
+            stack.push_back(nodes[f].low);
+            stack.push_back(nodes[f].high);
+        }
+
+        for (uint32_t f = 2; f < nodes.size(); ++f) {
+            if (nodes[f].varIndex < 0 || marked[f]) continue;
+            unlinkNode(f);
+            if (!isTerminal(nodes[f].low)) --refs[nodes[f].low];
+            if (!isTerminal(nodes[f].high)) --refs[nodes[f].high];
+            nodes[f] = {-1, FALSE_NODE, FALSE_NODE, NO_NODE};
+            refs[f] = 0;
+            freeNodes.push_back(f);
+        }
+
+        clearCache();
+        return before - liveNodes();
+    }
+
+    ReorderStats reorder(ReorderMethod method) {
+        auto start = std::chrono::steady_clock::now();
+        lastReorder = ReorderStats{};
+
+        collectGarbage();
+        lastReorder.nodesBefore = liveNodes();
+
+        if (numVars >= 2) {
+            if (method == ReorderMethod::SIFTING) {
+                sift();
+            } else if (method == ReorderMethod::WINDOW) {
+                windowPermute();
+            }
+        }
+
+        // в кеше могут остаться результаты, освобождённые при обменах
+        clearCache();
+        lastReorder.nodesAfter = liveNodes();
+        lastReorder.timeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        return lastReorder;
+    }
+
+    // Автоматическая перестановка при превышении порога числа узлов.
+    // Проверка выполняется в reorderIfNeeded между операциями, когда все
+    // нужные результаты удерживаются через addRef.
+    void setAutoReorder(ReorderMethod method, size_t threshold = AUTO_REORDER_THRESHOLD) {
+        autoMethod = method;
+        autoThreshold = threshold;
+    }
+
+    bool reorderIfNeeded() {
+        if (autoMethod == ReorderMethod::NONE || liveNodes() <= autoThreshold) {
+            return false;
+        }
+        reorder(autoMethod);
+        autoThreshold = std::max(autoThreshold, 2 * liveNodes());
+        return true;
+    }
+
+    const ReorderStats& getLastReorder() const { return lastReorder; }
+
+    uint64_t getCacheLookups() const { return cacheLookups; }
+    uint64_t getCacheHits() const { return cacheHits; }
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+// Беззнаковое целое произвольной длины для числа выполняющих наборов:
+// при n > 64 их может быть до 2^n. Только нужные операции: сложение,
+// сдвиг влево, сравнение, случайное число ниже границы, запись в десятичной.
+// Цифры по 64 бита, младшие первыми, без ведущих нулей.
+class BigUInt {
+private:
+    std::vector<uint64_t> limbs;
+
+    void trim() {
+        while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+    }
+
+    // деление на малое число на месте, возвращает остаток
+    uint64_t divide(uint64_t divisor) {
+        unsigned __int128 remainder = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            unsigned __int128 current = (remainder << 64) | limbs[i];
+            limbs[i] = static_cast<uint64_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        trim();
+        return static_cast<uint64_t>(remainder);
+    }
+
+public:
+    BigUInt(uint64_t value = 0) {
+        if (value != 0) limbs.push_back(value);
+    }
+
+    bool isZero() const { return limbs.empty(); }
+
+    size_t bitLength() const {
+        if (limbs.empty()) return 0;
+        return 64 * limbs.size() - __builtin_clzll(limbs.back());
+    }
+
+    bool fitsUint64() const { return limbs.size() <= 1; }
+    uint64_t toUint64() const { return limbs.empty() ? 0 : limbs[0]; }
+
+    BigUInt& operator+=(const BigUInt& other) {
+        if (other.limbs.size() > limbs.size()) limbs.resize(other.limbs.size(), 0);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            if (i >= other.limbs.size() && carry == 0) break;
+            uint64_t addend = i < other.limbs.size() ? other.limbs[i] : 0;
+            unsigned __int128 sum = (unsigned __int128)limbs[i] + addend + carry;
+            limbs[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+        if (carry) limbs.push_back(carry);
+        return *this;
+    }
+
+    BigUInt operator+(const BigUInt& other) const {
+        BigUInt result(*this);
+        result += other;
+        return result;
+    }
+
+    BigUInt operator<<(size_t shift) const {
+        if (limbs.empty() || shift == 0) return *this;
+        BigUInt result;
+        size_t whole = shift / 64, bits = shift % 64;
+        result.limbs.assign(limbs.size() + whole + 1, 0);
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            result.limbs[i + whole] |= limbs[i] << bits;
+            if (bits) result.limbs[i + whole + 1] |= limbs[i] >> (64 - bits);
+        }
+        result.trim();
+        return result;
+    }
+
+    bool operator<(const BigUInt& other) const {
+        if (limbs.size() != other.limbs.size()) return limbs.size() < other.limbs.size();
+        return std::lexicographical_compare(limbs.rbegin(), limbs.rend(),
+                                            other.limbs.rbegin(), other.limbs.rend());
+    }
+
+    bool operator==(const BigUInt& other) const { return limbs == other.limbs; }
+    bool operator!=(const BigUInt& other) const { return limbs != other.limbs; }
+
+    // Равномерно случайное число из [0, bound), bound > 0: случайные биты
+    // длины bound с отбрасыванием (в среднем меньше двух попыток)
+    template<typename Rng>
+    static BigUInt randomBelow(const BigUInt& bound, Rng& rng) {
+        size_t bits = bound.bitLength();
+        BigUInt result;
+        do {
+            result.limbs.assign(bound.limbs.size(), 0);
+            for (uint64_t& limb : result.limbs) limb = rng();
+            if (bits % 64) result.limbs.back() &= (1ULL << (bits % 64)) - 1;
+            result.trim();
+        } while (!(result < bound));
+        return result;
+    }
+
+    std::string toString() const {
+        if (limbs.empty()) return "0";
+        static constexpr uint64_t CHUNK = 10000000000000000000ULL;  // 10^19
+        BigUInt rest(*this);
+        std::string result;
+        while (!rest.isZero()) {
+            uint64_t chunk = rest.divide(CHUNK);
+            std::string digits = std::to_string(chunk);
+            if (!rest.isZero()) digits.insert(0, 19 - digits.size(), '0');
+            result.insert(0, digits);
+        }
+        return result;
+    }
+};
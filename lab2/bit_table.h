@@ -0,0 +1,370 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include "parallel.h"
+
+// Упакованная таблица истинности: строка r хранится битом (r & 63)
+// слова r >> 6. Как и в TruthTable, старший бит номера строки - x1,
+// то есть переменная x(j+1) соответствует биту (n - 1 - j) номера строки.
+// Неиспользуемые старшие биты единственного слова при n < 6 всегда нулевые.
+class BitTable {
+private:
+    int numVars;
+    std::vector<uint64_t> words;
+
+    // Слово, в котором установлены строки с единичным битом b номера (b < 6)
+    static constexpr uint64_t VAR_MASKS[6] = {
+        0xAAAAAAAAAAAAAAAAULL,
+        0xCCCCCCCCCCCCCCCCULL,
+        0xF0F0F0F0F0F0F0F0ULL,
+        0xFF00FF00FF00FF00ULL,
+        0xFFFF0000FFFF0000ULL,
+        0xFFFFFFFF00000000ULL,
+    };
+
+    uint64_t tailMask() const {
+        return numVars >= 6 ? ~0ULL : (1ULL << (size_t(1) << numVars)) - 1;
+    }
+
+    void checkCompatible(const BitTable& other) const {
+        if (numVars != other.numVars) {
+            throw std::invalid_argument("Таблицы истинности разной размерности");
+        }
+    }
+
+    int rowBit(int var) const {
+        if (var < 0 || var >= numVars) {
+            throw std::out_of_range("Номер переменной вне диапазона");
+        }
+        return numVars - 1 - var;
+    }
+
+    // Проверка check(f0, f1) для всех пар слов, в которых на местах строк
+    // с нулевым битом b стоят значения кофакторов f|b=0 и f|b=1; без копий
+    template<typename Check>
+    bool allCofactorPairs(int b, Check check) const {
+        if (b < 6) {
+            uint64_t mask = ~VAR_MASKS[b] & tailMask();
+            int shift = 1 << b;
+            for (uint64_t w : words) {
+                if (!check(w & mask, (w >> shift) & mask)) return false;
+            }
+        } else {
+            size_t step = size_t(1) << (b - 6);
+            for (size_t block = 0; block < words.size(); block += 2 * step) {
+                for (size_t i = block; i < block + step; ++i) {
+                    if (!check(words[i], words[i + step])) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static uint64_t reverseBits(uint64_t w) {
+        w = ((w >> 1) & 0x5555555555555555ULL) | ((w & 0x5555555555555555ULL) << 1);
+        w = ((w >> 2) & 0x3333333333333333ULL) | ((w & 0x3333333333333333ULL) << 2);
+        w = ((w >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((w & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        return __builtin_bswap64(w);
+    }
+
+    // high[j] ^= low[j]: отрезки не пересекаются, цикл векторизуется
+    static void xorWords(uint64_t* __restrict high, const uint64_t* __restrict low, size_t count) {
+        for (size_t j = 0; j < count; ++j) {
+            high[j] ^= low[j];
+        }
+    }
+
+public:
+    static constexpr int MAX_VARS = 36;
+
+    explicit BitTable(int n = 0) : numVars(n) {
+        if (n < 0 || n > MAX_VARS) {
+            throw std::invalid_argument("Недопустимое число переменных");
+        }
+        words.assign(n >= 6 ? size_t(1) << (n - 6) : 1, 0);
+    }
+
+    static BitTable fromValues(int n, const std::vector<int>& values) {
+        BitTable table(n);
+        if (values.size() != table.rows()) {
+            throw std::invalid_argument("Размер таблицы истинности не равен 2^n");
+        }
+        for (size_t r = 0; r < values.size(); ++r) {
+            if (values[r]) table.words[r >> 6] |= 1ULL << (r & 63);
+        }
+        return table;
+    }
+
+    // Таблица из готовых слов (строка r - бит r & 63 слова r >> 6); биты
+    // за последней строкой при n < 6 должны быть нулевыми
+    static BitTable fromWords(int n, std::vector<uint64_t> words) {
+        BitTable table;
+        if (n < 0 || n > MAX_VARS) {
+            throw std::invalid_argument("Недопустимое число переменных");
+        }
+        if (words.size() != (n >= 6 ? size_t(1) << (n - 6) : 1)
+            || (n < 6 && (words[0] >> (size_t(1) << n)) != 0)) {
+            throw std::invalid_argument("Размер таблицы истинности не равен 2^n");
+        }
+        table.numVars = n;
+        table.words = std::move(words);
+        return table;
+    }
+
+    std::vector<int> toValues() const {
+        std::vector<int> values(rows());
+        for (size_t r = 0; r < values.size(); ++r) {
+            values[r] = get(r);
+        }
+        return values;
+    }
+
+    int getNumVars() const { return numVars; }
+    size_t rows() const { return size_t(1) << numVars; }
+
+    std::vector<uint64_t>& getWords() { return words; }
+    const std::vector<uint64_t>& getWords() const { return words; }
+
+    int get(size_t row) const {
+        return static_cast<int>((words[row >> 6] >> (row & 63)) & 1);
+    }
+
+    void set(size_t row, bool value) {
+        uint64_t bit = 1ULL << (row & 63);
+        if (value) {
+            words[row >> 6] |= bit;
+        } else {
+            words[row >> 6] &= ~bit;
+        }
+    }
+
+    BitTable& operator&=(const BitTable& other) {
+        checkCompatible(other);
+        for (size_t i = 0; i < words.size(); ++i) words[i] &= other.words[i];
+        return *this;
+    }
+
+    BitTable& operator|=(const BitTable& other) {
+        checkCompatible(other);
+        for (size_t i = 0; i < words.size(); ++i) words[i] |= other.words[i];
+        return *this;
+    }
+
+    BitTable& operator^=(const BitTable& other) {
+        checkCompatible(other);
+        for (size_t i = 0; i < words.size(); ++i) words[i] ^= other.words[i];
+        return *this;
+    }
+
+    BitTable operator~() const {
+        BitTable result(*this);
+        for (uint64_t& w : result.words) w = ~w;
+        result.words.back() &= tailMask();
+        return result;
+    }
+
+    friend BitTable operator&(BitTable a, const BitTable& b) { return a &= b; }
+    friend BitTable operator|(BitTable a, const BitTable& b) { return a |= b; }
+    friend BitTable operator^(BitTable a, const BitTable& b) { return a ^= b; }
+
+    bool operator==(const BitTable& other) const {
+        return numVars == other.numVars && words == other.words;
+    }
+
+    bool operator!=(const BitTable& other) const {
+        return !(*this == other);
+    }
+
+    // Таблица переменной x(var+1)
+    static BitTable variable(int n, int var) {
+        BitTable table(n);
+        int b = table.rowBit(var);
+
+        if (b < 6) {
+            for (uint64_t& w : table.words) w = VAR_MASKS[b];
+            table.words.back() &= table.tailMask();
+        } else {
+            size_t step = size_t(1) << (b - 6);
+            for (size_t i = 0; i < table.words.size(); ++i) {
+                if (i & step) table.words[i] = ~0ULL;
+            }
+        }
+        return table;
+    }
+
+    // Установить в 1 все строки куба: бит b номера строки фиксирован, если
+    // он есть в care, и тогда равен биту b из value. Младшие 6 бит задают
+    // маску внутри слова, по свободным старшим перебираются только слова.
+    void setCube(uint64_t value, uint64_t care) {
+        uint64_t inWord = tailMask();
+        for (int b = 0; b < std::min(numVars, 6); ++b) {
+            if (care & (1ULL << b)) {
+                inWord &= (value & (1ULL << b)) ? VAR_MASKS[b] : ~VAR_MASKS[b];
+            }
+        }
+
+        uint64_t wordBits = words.size() - 1;
+        uint64_t fixed = ((value & care) >> 6) & wordBits;
+        uint64_t free = (~care >> 6) & wordBits;
+        uint64_t sub = 0;
+        do {
+            words[fixed | sub] |= inWord;
+            sub = (sub - free) & free;
+        } while (sub != 0);
+    }
+
+    // Кофактор f|x(var+1)=value над теми же n переменными: половина строк
+    // с нужным значением переменной копируется на место другой половины
+    BitTable cofactor(int var, bool value) const {
+        BitTable result(*this);
+        int b = rowBit(var);
+
+        if (b < 6) {
+            uint64_t mask = VAR_MASKS[b];
+            int shift = 1 << b;
+            for (uint64_t& w : result.words) {
+                if (value) {
+                    uint64_t high = w & mask;
+                    w = high | (high >> shift);
+                } else {
+                    uint64_t low = w & ~mask;
+                    w = low | (low << shift);
+                }
+            }
+            result.words.back() &= tailMask();
+        } else {
+            size_t step = size_t(1) << (b - 6);
+            for (size_t block = 0; block < words.size(); block += 2 * step) {
+                for (size_t i = block; i < block + step; ++i) {
+                    uint64_t w = value ? words[i + step] : words[i];
+                    result.words[i] = w;
+                    result.words[i + step] = w;
+                }
+            }
+        }
+        return result;
+    }
+
+    bool dependsOn(int var) const {
+        return !allCofactorPairs(rowBit(var), [](uint64_t f0, uint64_t f1) {
+            return f0 == f1;
+        });
+    }
+
+    // f|x=0 <= f|x=1 (функция не убывает по x(var+1))
+    bool monotoneIn(int var) const {
+        return allCofactorPairs(rowBit(var), [](uint64_t f0, uint64_t f1) {
+            return (f0 & ~f1) == 0;
+        });
+    }
+
+    // Симметричность по паре переменных: f|xp=0,xq=1 == f|xp=1,xq=0, то есть
+    // строка r с битами p = 0, q = 1 совпадает со строкой r + 2^p - 2^q
+    bool symmetricIn(int var1, int var2) const {
+        int p = rowBit(var1), q = rowBit(var2);
+        if (p == q) return true;
+        if (p < q) std::swap(p, q);
+
+        if (p < 6) {
+            uint64_t mask = ~VAR_MASKS[p] & VAR_MASKS[q];
+            int shift = (1 << p) - (1 << q);
+            for (uint64_t w : words) {
+                if ((w & mask) != ((w >> shift) & mask)) return false;
+            }
+        } else if (q < 6) {
+            size_t step = size_t(1) << (p - 6);
+            int shift = 1 << q;
+            for (size_t block = 0; block < words.size(); block += 2 * step) {
+                for (size_t i = block; i < block + step; ++i) {
+                    if (((words[i] & VAR_MASKS[q]) >> shift) != (words[i + step] & ~VAR_MASKS[q])) {
+                        return false;
+                    }
+                }
+            }
+        } else {
+            size_t stepP = size_t(1) << (p - 6), stepQ = size_t(1) << (q - 6);
+            for (size_t i = 0; i < words.size(); ++i) {
+                if ((i & stepP) == 0 && (i & stepQ) != 0 && words[i] != words[i + stepP - stepQ]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // f(¬x) = ¬f(x): строка r против строки rows - 1 - r, то есть таблица
+    // против своего зеркального отражения с инверсией, по словам
+    bool isSelfDual() const {
+        int unused = numVars >= 6 ? 0 : 64 - (1 << numVars);
+        size_t count = words.size();
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t mirrored = reverseBits(words[count - 1 - i]) >> unused;
+            if (words[i] != (~mirrored & tailMask())) return false;
+        }
+        return true;
+    }
+
+    // Преобразование Мёбиуса на месте: таблица значений <-> коэффициенты
+    // полинома Жегалкина (преобразование - инволюция). Для младших шести
+    // битов номера строки "бабочка" выполняется сдвигами внутри слова,
+    // для старших - XOR непрерывных отрезков слов длины 2^(b-6) в блоках
+    // по 2^(b-5) слов, который векторизуется компилятором. При threads > 1
+    // каждый проход делится между потоками по блокам.
+    void mobiusTransform(unsigned threads = 1) {
+        int inWordBits = std::min(numVars, 6);
+
+        parallelFor(words.size(), threads, [this, inWordBits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                uint64_t w = words[i];
+                for (int b = 0; b < inWordBits; ++b) {
+                    w ^= (w & ~VAR_MASKS[b]) << (1 << b);
+                }
+                words[i] = w;
+            }
+        });
+
+        for (int b = 6; b < numVars; ++b) {
+            size_t step = size_t(1) << (b - 6);
+            size_t blocks = words.size() / (2 * step);
+            uint64_t* data = words.data();
+            if (blocks >= threads) {
+                parallelFor(blocks, threads, [data, step](size_t begin, size_t end) {
+                    for (size_t block = begin; block < end; ++block) {
+                        uint64_t* low = data + block * 2 * step;
+                        xorWords(low + step, low, step);
+                    }
+                });
+            } else {
+                // старшие биты: блоков меньше, чем потоков, делится сам блок
+                for (size_t block = 0; block < blocks; ++block) {
+                    uint64_t* low = data + block * 2 * step;
+                    parallelFor(step, threads, [low, step](size_t begin, size_t end) {
+                        xorWords(low + step + begin, low + begin, end - begin);
+                    });
+                }
+            }
+        }
+    }
+
+    // Вес функции - число единичных строк
+    uint64_t weight() const {
+        uint64_t count = 0;
+        for (uint64_t w : words) {
+            count += static_cast<uint64_t>(__builtin_popcountll(w));
+        }
+        return count;
+    }
+
+    bool isZero() const {
+        for (uint64_t w : words) {
+            if (w) return false;
+        }
+        return true;
+    }
+
+    size_t memoryBytes() const {
+        return words.size() * sizeof(uint64_t);
+    }
+};
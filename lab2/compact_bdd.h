@@ -0,0 +1,172 @@
+#pragma once
+#include "bdd_manager.h"
+
+// Вычисление по массиву рёбер компактной БДР, которым не владеет:
+// рёбрам CompactBDD или файлу, отображённому в память (см. MappedBDD)
+struct CompactBDDView {
+    static constexpr int SHIFT_BITS = 26;
+    static constexpr uint32_t INDEX_MASK = (1u << SHIFT_BITS) - 1;
+    static constexpr uint32_t FIRST_NODE = 2;
+
+    int numVars;
+    uint32_t rootEdge;
+    int depth;
+    const uint32_t* edges;
+
+    // Значение на упакованном наборе (старший бит - x1)
+    int evaluate(uint64_t input) const {
+        uint32_t e = rootEdge;
+        while ((e & INDEX_MASK) >= FIRST_NODE) {
+            e = edges[2 * (e & INDEX_MASK) + ((input >> (e >> SHIFT_BITS)) & 1)];
+        }
+        return static_cast<int>(e);
+    }
+
+    // Вычисление на count <= 64 наборах: все обходы делают depth шагов
+    // одновременно (листья переходят сами в себя), так что независимые
+    // загрузки перекрываются, а ветвлений по форме пути нет.
+    // Бит k результата - значение на inputs[k].
+    uint64_t evaluate64(const uint64_t* inputs, size_t count) const {
+        uint32_t current[64];
+        std::fill(current, current + count, rootEdge);
+
+        for (int step = 0; step < depth; ++step) {
+            for (size_t k = 0; k < count; ++k) {
+                uint32_t e = current[k];
+                current[k] = edges[2 * (e & INDEX_MASK) + ((inputs[k] >> (e >> SHIFT_BITS)) & 1)];
+            }
+        }
+
+        uint64_t result = 0;
+        for (size_t k = 0; k < count; ++k) {
+            result |= uint64_t(current[k]) << k;
+        }
+        return result;
+    }
+
+    // Таблица истинности по 64 строки за проход evaluate64
+    BitTable toBitTable() const {
+        BitTable table(numVars);
+        std::vector<uint64_t>& words = table.getWords();
+
+        uint64_t rows[64];
+        size_t count = std::min<size_t>(64, table.rows());
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (size_t k = 0; k < count; ++k) {
+                rows[k] = w * 64 + k;
+            }
+            words[w] = evaluate64(rows, count);
+        }
+        return table;
+    }
+};
+
+// Компактное неизменяемое представление БДР одного корня.
+// Узел - два 32-битных ребра (по 0 и по 1), 8 байт вместо 16 у BDDNode.
+// Младшие 26 бит ребра - номер узла, старшие 6 - бит упакованного набора,
+// проверяемый в этом узле, так что при обходе переменную не нужно искать
+// (поэтому переменных не более 64).
+// Номера 0 и 1 - листья: в массиве рёбер они ссылаются сами на себя.
+// Узлы уложены обходом в ширину по уровням (BDDManager::levelOrder), так
+// что слой L занимает непрерывный отрезок номеров [layerOffsets[L],
+// layerOffsets[L + 1]) + 2, а переменная слоя хранится один раз.
+class CompactBDD {
+private:
+    static constexpr int SHIFT_BITS = CompactBDDView::SHIFT_BITS;
+    static constexpr uint32_t INDEX_MASK = CompactBDDView::INDEX_MASK;
+
+    int numVars;
+    uint32_t rootEdge;
+    int depth;                           // длина самого длинного пути
+    std::vector<uint32_t> edges;         // по два на узел, включая листья
+    std::vector<uint32_t> layerOffsets;  // numVars + 1 границ слоёв
+    std::vector<int> layerVars;          // переменная слоя
+
+    static uint32_t makeEdge(uint32_t index, uint32_t shift) {
+        return (shift << SHIFT_BITS) | index;
+    }
+
+public:
+    static constexpr uint32_t FALSE_EDGE = 0;
+    static constexpr uint32_t TRUE_EDGE = 1;
+    static constexpr uint32_t FIRST_NODE = CompactBDDView::FIRST_NODE;
+    static constexpr size_t MAX_NODES = INDEX_MASK + 1 - FIRST_NODE;
+
+    CompactBDD(const BDDManager& manager, uint32_t root) : numVars(manager.getNumVars()) {
+        if (numVars > 64) {
+            throw std::invalid_argument("Компактное представление БДР - не более 64 переменных");
+        }
+        std::vector<uint32_t> order = manager.levelOrder({root});
+        if (order.size() > MAX_NODES) {
+            throw std::length_error("БДР слишком велика для компактного представления");
+        }
+
+        uint32_t maxId = root;
+        for (uint32_t f : order) maxId = std::max(maxId, f);
+
+        layerVars = manager.getOrder();
+        std::vector<uint32_t> edgeOf(maxId + 2, FALSE_EDGE);
+        edgeOf[BDDManager::TRUE_NODE] = TRUE_EDGE;
+        for (size_t i = 0; i < order.size(); ++i) {
+            uint32_t shift = static_cast<uint32_t>(numVars - 1 - manager.node(order[i]).varIndex);
+            edgeOf[order[i]] = makeEdge(static_cast<uint32_t>(i) + FIRST_NODE, shift);
+        }
+        rootEdge = edgeOf[root];
+
+        edges = {FALSE_EDGE, FALSE_EDGE, TRUE_EDGE, TRUE_EDGE};
+        edges.reserve(2 * (order.size() + FIRST_NODE));
+        layerOffsets.assign(numVars + 1, 0);
+        for (uint32_t f : order) {
+            const BDDNode& node = manager.node(f);
+            edges.push_back(edgeOf[node.low]);
+            edges.push_back(edgeOf[node.high]);
+            ++layerOffsets[manager.level(f) + 1];
+        }
+        for (int lvl = 0; lvl < numVars; ++lvl) {
+            layerOffsets[lvl + 1] += layerOffsets[lvl];
+        }
+
+        // потомки лежат дальше по массиву, поэтому проход с конца
+        std::vector<int> pathLength(nodeCount() + FIRST_NODE, 0);
+        for (size_t i = pathLength.size(); i-- > FIRST_NODE;) {
+            pathLength[i] = 1 + std::max(pathLength[edgeIndex(edges[2 * i])],
+                                         pathLength[edgeIndex(edges[2 * i + 1])]);
+        }
+        depth = pathLength[edgeIndex(rootEdge)];
+    }
+
+    int getNumVars() const { return numVars; }
+    uint32_t getRootEdge() const { return rootEdge; }
+    int getDepth() const { return depth; }
+    const std::vector<uint32_t>& getEdges() const { return edges; }
+    const std::vector<uint32_t>& getLayerOffsets() const { return layerOffsets; }
+    const std::vector<int>& getLayerVars() const { return layerVars; }
+
+    static uint32_t edgeIndex(uint32_t edge) { return edge & INDEX_MASK; }
+    static uint32_t edgeShift(uint32_t edge) { return edge >> SHIFT_BITS; }
+
+    size_t nodeCount() const { return edges.size() / 2 - FIRST_NODE; }
+
+    size_t memoryBytes() const {
+        return (edges.size() + layerOffsets.size()) * sizeof(uint32_t)
+             + layerVars.size() * sizeof(int);
+    }
+
+    // Вычисление без копирования рёбер (см. CompactBDDView)
+    CompactBDDView view() const {
+        return {numVars, rootEdge, depth, edges.data()};
+    }
+
+    // Значение на упакованном наборе (старший бит - x1)
+    int evaluate(uint64_t input) const {
+        return view().evaluate(input);
+    }
+
+    uint64_t evaluate64(const uint64_t* inputs, size_t count) const {
+        return view().evaluate64(inputs, count);
+    }
+
+    BitTable toBitTable() const {
+        return view().toBitTable();
+    }
+};
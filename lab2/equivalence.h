@@ -0,0 +1,282 @@
+#pragma once
+#include "bdd.h"
+#include "parallel_bdd.h"
+#include <chrono>
+#include <random>
+
+// Итог проверки согласованности представлений
+struct EquivalenceResult {
+    bool equivalent = true;
+    bool exhaustive = false;
+    uint64_t checked = 0;
+    double timeMs = 0.0;
+
+    // первый найденный набор, на котором представления расходятся
+    uint64_t counterexample = 0;
+    int tableValue = 0;
+    int polynomialValue = 0;
+    int bddValue = 0;
+};
+
+// Проверка того, что таблица истинности, полином Жегалкина и БДР одной
+// функции совпадают: полным перебором наборов или на случайной выборке.
+// Наборы обрабатываются блоками через пакетные вычислители (многопоточные,
+// для полинома - битовые срезы). Та же схема служит бенчмарком скорости
+// вычисления каждого представления.
+class EquivalenceChecker : public CliUI {
+private:
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+    static constexpr size_t BENCHMARK_INPUTS = 1 << 20;
+    static constexpr int BENCHMARK_MIN_VARS = 4;
+    static constexpr int BENCHMARK_MAX_VARS = 28;
+    static constexpr int APPLY_MIN_VARS = 8;
+    static constexpr int APPLY_MAX_VARS = 40;
+    static constexpr int APPLY_MAX_CUBES = 60;
+
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Сравнить блок наборов; при расхождении заполнить контрпример
+    static bool checkBlock(const BDD& f, const std::vector<uint64_t>& inputs, EquivalenceResult& result) {
+        std::vector<uint64_t> table = f.evaluateBatch(inputs);
+        std::vector<uint64_t> polynomial = f.evaluatePolynomialBatch(inputs);
+        std::vector<uint64_t> bdd = f.evaluateBDDBatch(inputs);
+
+        for (size_t w = 0; w < table.size(); ++w) {
+            uint64_t diff = (table[w] ^ polynomial[w]) | (table[w] ^ bdd[w]);
+            if (diff == 0) continue;
+
+            size_t k = w * 64 + __builtin_ctzll(diff);
+            result.equivalent = false;
+            result.checked += k + 1;
+            result.counterexample = inputs[k];
+            result.tableValue = static_cast<int>((table[w] >> (k % 64)) & 1);
+            result.polynomialValue = static_cast<int>((polynomial[w] >> (k % 64)) & 1);
+            result.bddValue = static_cast<int>((bdd[w] >> (k % 64)) & 1);
+            return false;
+        }
+
+        result.checked += inputs.size();
+        return true;
+    }
+
+    // Случайная функция с разреженным полиномом из 2n мономов степени до 3:
+    // таблица, полином и БДР остаются обозримыми вплоть до 28 переменных
+    static BitTable randomFunction(int n, std::mt19937_64& rng) {
+        BitTable table(n);
+        std::uniform_int_distribution<int> var(0, n - 1);
+        for (int i = 0; i < 2 * n; ++i) {
+            uint64_t mask = 0;
+            for (int d = 0; d < 3; ++d) {
+                mask |= 1ULL << var(rng);
+            }
+            table.set(mask, true);
+        }
+        table.mobiusTransform(chooseThreads(table.getWords().size(), 1 << 14));
+        return table;
+    }
+
+    // Сумма по модулю 2 случайных конъюнкций до 4 литералов: размер БДР
+    // быстро растёт с числом конъюнкций, что даёт тяжёлый apply
+    static uint32_t randomXorOfCubes(BDDManager& manager, int cubes, std::mt19937_64& rng) {
+        int n = manager.getNumVars();
+        uint32_t result = manager.addRef(BDDManager::FALSE_NODE);
+        for (int c = 0; c < cubes; ++c) {
+            uint64_t care = 0;
+            for (int k = 0; k < 4; ++k) {
+                care |= 1ULL << (rng() % n);
+            }
+            uint32_t next = manager.addRef(manager.apply(BDDOp::XOR, result, manager.cube(rng(), care)));
+            manager.release(result);
+            result = next;
+        }
+        return result;
+    }
+
+    template<typename Evaluate>
+    static double throughput(const std::vector<uint64_t>& inputs, Evaluate evaluate) {
+        Clock::time_point start = Clock::now();
+        std::vector<uint64_t> results = evaluate(inputs);
+        double ms = elapsedMs(start);
+        return ms > 0.0 ? inputs.size() / (ms * 1000.0) : 0.0;
+    }
+
+    void printResult(const BDD& f, const EquivalenceResult& result) const {
+        std::cout << (result.exhaustive ? "Полный перебор" : "Случайная выборка")
+                  << ": проверено наборов " << result.checked
+                  << " за " << std::fixed << std::setprecision(3) << result.timeMs << " мс\n";
+
+        if (result.equivalent) {
+            std::cout << "Представления совпадают\n";
+            return;
+        }
+
+        int n = f.getNumVars();
+        std::cout << "Расхождение на наборе (";
+        for (int j = 0; j < n; ++j) {
+            if (j > 0) std::cout << ", ";
+            std::cout << ((result.counterexample >> (n - 1 - j)) & 1);
+        }
+        std::cout << "): таблица = " << result.tableValue
+                  << ", полином = " << result.polynomialValue
+                  << ", БДР = " << result.bddValue << "\n";
+    }
+
+public:
+    static EquivalenceResult checkExhaustive(const BDD& f) {
+        EquivalenceResult result;
+        result.exhaustive = true;
+        Clock::time_point start = Clock::now();
+
+        uint64_t rows = f.getTable().rows();
+        std::vector<uint64_t> inputs;
+        for (uint64_t first = 0; first < rows; first += BLOCK_SIZE) {
+            inputs.resize(std::min<uint64_t>(BLOCK_SIZE, rows - first));
+            for (size_t k = 0; k < inputs.size(); ++k) {
+                inputs[k] = first + k;
+            }
+            if (!checkBlock(f, inputs, result)) break;
+        }
+
+        result.timeMs = elapsedMs(start);
+        return result;
+    }
+
+    static EquivalenceResult checkRandom(const BDD& f, uint64_t samples, uint64_t seed) {
+        EquivalenceResult result;
+        Clock::time_point start = Clock::now();
+
+        std::mt19937_64 rng(seed);
+        uint64_t rowMask = f.getTable().rows() - 1;
+        std::vector<uint64_t> inputs;
+        for (uint64_t done = 0; done < samples; done += inputs.size()) {
+            inputs.resize(std::min<uint64_t>(BLOCK_SIZE, samples - done));
+            for (uint64_t& input : inputs) {
+                input = rng() & rowMask;
+            }
+            if (!checkBlock(f, inputs, result)) break;
+        }
+
+        result.timeMs = elapsedMs(start);
+        return result;
+    }
+
+    void interactiveCheck(const BDD& f) {
+        printHeader("ПРОВЕРКА СОГЛАСОВАННОСТИ ПРЕДСТАВЛЕНИЙ");
+
+        std::cout << "1. Полный перебор наборов\n";
+        std::cout << "2. Случайная выборка\n";
+        int mode = getUserInput("Режим: ", 1, 2);
+
+        EquivalenceResult result;
+        if (mode == 1) {
+            result = checkExhaustive(f);
+        } else {
+            int samples = getUserInput("Число наборов (1..100000000): ", 1, 100000000);
+            result = checkRandom(f, static_cast<uint64_t>(samples), std::random_device{}());
+        }
+        printResult(f, result);
+    }
+
+    // Скорость вычисления (млн наборов/с) каждого представления для n из
+    // [minVars, maxVars] с шагом step на случайных разреженных функциях;
+    // для каждой функции дополнительно выполняется случайная проверка
+    void runBenchmark(int minVars, int maxVars, int step) {
+        printHeader("БЕНЧМАРК ВЫЧИСЛЕНИЯ");
+
+        std::cout << "  n | таблица | полином |     БДР | мономов | узлов БДР | совпадают\n";
+        printSeparator();
+
+        std::mt19937_64 rng(2024);
+        for (int n = minVars; n <= maxVars; n += step) {
+            BDD f(randomFunction(n, rng));
+
+            std::vector<uint64_t> inputs(BENCHMARK_INPUTS);
+            for (uint64_t& input : inputs) {
+                input = rng();
+            }
+
+            double table = throughput(inputs, [&f](const std::vector<uint64_t>& in) {
+                return f.evaluateBatch(in);
+            });
+            double polynomial = throughput(inputs, [&f](const std::vector<uint64_t>& in) {
+                return f.evaluatePolynomialBatch(in);
+            });
+            double bdd = throughput(inputs, [&f](const std::vector<uint64_t>& in) {
+                return f.evaluateBDDBatch(in);
+            });
+            EquivalenceResult check = checkRandom(f, BENCHMARK_INPUTS, rng());
+
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(3) << n << " | "
+                      << std::setw(7) << table << " | "
+                      << std::setw(7) << polynomial << " | "
+                      << std::setw(7) << bdd << " | "
+                      << std::setw(7) << f.getMonomials().size() << " | "
+                      << std::setw(9) << f.getManager().countNodes(f.getRoot()) << " | "
+                      << (check.equivalent ? "да" : "НЕТ") << "\n";
+        }
+        std::cout << "\nСкорость - млн наборов в секунду, по "
+                  << BENCHMARK_INPUTS << " случайных наборов\n";
+    }
+
+    void interactiveBenchmark() {
+        int minVars = getUserInput("Минимальное n (4..28): ", BENCHMARK_MIN_VARS, BENCHMARK_MAX_VARS);
+        int maxVars = getUserInput("Максимальное n (" + std::to_string(minVars) + "..28): ",
+                                   minVars, BENCHMARK_MAX_VARS);
+        int step = getUserInput("Шаг (1..24): ", 1, BENCHMARK_MAX_VARS - BENCHMARK_MIN_VARS);
+        runBenchmark(minVars, maxVars, step);
+    }
+
+    // Время apply(AND) двух случайных БДР от n переменных при числе потоков
+    // 1, 2, 4, ... до числа ядер; перед каждым запуском кеш вычислений
+    // очищается сборкой мусора, результат сверяется с однопоточным
+    void runApplyBenchmark(int n, int cubes) {
+        printHeader("БЕНЧМАРК ПАРАЛЛЕЛЬНОГО APPLY");
+
+        std::mt19937_64 rng(2024);
+        ParallelBDDManager manager(n);
+        uint32_t f = randomXorOfCubes(manager, cubes, rng);
+        uint32_t g = randomXorOfCubes(manager, cubes, rng);
+        std::cout << "Узлов в операндах: " << manager.countNodes(f) << " и " << manager.countNodes(g) << "\n";
+        printSeparator();
+
+        std::cout << " потоков |    время, мс | ускорение | узлов результата | совпадает\n";
+        printSeparator();
+
+        unsigned hardware = std::max(std::thread::hardware_concurrency(), 2u);
+        uint32_t reference = BDDManager::FALSE_NODE;
+        double baseMs = 0.0;
+        for (unsigned threads = 1; threads <= hardware; threads *= 2) {
+            manager.collectGarbage();
+
+            Clock::time_point start = Clock::now();
+            uint32_t result = manager.parallelApply(BDDOp::AND, f, g, threads);
+            double ms = elapsedMs(start);
+            if (threads == 1) {
+                baseMs = ms;
+                reference = manager.addRef(result);
+            }
+            bool same = result == reference;
+
+            std::cout << std::setw(8) << threads << " | "
+                      << std::fixed << std::setprecision(1) << std::setw(12) << ms << " | "
+                      << std::setprecision(2) << std::setw(9) << (ms > 0.0 ? baseMs / ms : 0.0) << " | "
+                      << std::setw(16) << manager.countNodes(result) << " | "
+                      << (same ? "да" : "НЕТ") << "\n";
+        }
+    }
+
+    void interactiveApplyBenchmark() {
+        int n = getUserInput("Число переменных (8..40): ", APPLY_MIN_VARS, APPLY_MAX_VARS);
+        int cubes = getUserInput("Число конъюнкций в операнде (1..60): ", 1, APPLY_MAX_CUBES);
+        try {
+            runApplyBenchmark(n, cubes);
+        } catch (const std::exception& e) {
+            std::cout << "Ошибка: " << e.what() << "\n";
+        }
+    }
+};
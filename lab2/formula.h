@@ -0,0 +1,402 @@
+#pragma once
+#include "bdd.h"
+#include <cctype>
+#include <chrono>
+#include <iterator>
+#include <map>
+
+// Узел дерева разбора формулы
+enum class FormulaOp {
+    CONST,
+    VAR,
+    NOT,
+    AND,
+    OR,
+    XOR,
+    IMPLIES,
+    EQUIV,
+};
+
+struct FormulaNode {
+    FormulaOp op;
+    int value;  // константа или номер переменной
+    int left;
+    int right;
+};
+
+// Булева формула с именованными переменными.
+// Операции по убыванию приоритета:
+//   ¬ ! ~            отрицание
+//   ∧ & *            конъюнкция
+//   ⊕ ^              сумма по модулю 2
+//   ∨ |              дизъюнкция
+//   → ->             импликация (правоассоциативна)
+//   ≡ ↔ <-> =        эквивалентность
+// Константы 0 и 1, имена - буква или '_', затем буквы, цифры, '_'.
+// Переменные нумеруются в порядке первого появления: первая - x1.
+// Формула компилируется прямо в БДР (apply) или в полином Жегалкина
+// (множество мономов), без таблицы истинности на 2^n строк.
+class Formula {
+private:
+    static constexpr size_t MAX_MONOMIALS = 1 << 22;
+
+    std::vector<std::string> variables;
+    std::vector<FormulaNode> nodes;  // потомки всегда раньше родителя
+    int root = -1;
+
+    // Рекурсивный спуск по тексту
+    class Parser {
+    private:
+        Formula& formula;
+        const std::string& text;
+        size_t pos = 0;
+        std::map<std::string, int> names;
+
+        void skipSpaces() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+                ++pos;
+            }
+        }
+
+        bool accept(const char* token) {
+            skipSpaces();
+            size_t length = std::char_traits<char>::length(token);
+            if (text.compare(pos, length, token) == 0) {
+                pos += length;
+                return true;
+            }
+            return false;
+        }
+
+        bool acceptAny(std::initializer_list<const char*> tokens) {
+            for (const char* token : tokens) {
+                if (accept(token)) return true;
+            }
+            return false;
+        }
+
+        [[noreturn]] void fail(const std::string& message) const {
+            throw std::invalid_argument(message + " (позиция " + std::to_string(pos + 1) + ")");
+        }
+
+        int add(FormulaOp op, int left, int right) {
+            formula.nodes.push_back({op, 0, left, right});
+            return static_cast<int>(formula.nodes.size()) - 1;
+        }
+
+        int leaf(FormulaOp op, int value) {
+            formula.nodes.push_back({op, value, -1, -1});
+            return static_cast<int>(formula.nodes.size()) - 1;
+        }
+
+        static bool isNameStart(char c) {
+            return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        static bool isNameChar(char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        int parseEquiv() {
+            int left = parseImplies();
+            while (acceptAny({"≡", "↔", "<->", "="})) {
+                left = add(FormulaOp::EQUIV, left, parseImplies());
+            }
+            return left;
+        }
+
+        int parseImplies() {
+            int left = parseOr();
+            if (acceptAny({"→", "->"})) {
+                return add(FormulaOp::IMPLIES, left, parseImplies());
+            }
+            return left;
+        }
+
+        int parseOr() {
+            int left = parseXor();
+            while (acceptAny({"∨", "|"})) {
+                left = add(FormulaOp::OR, left, parseXor());
+            }
+            return left;
+        }
+
+        int parseXor() {
+            int left = parseAnd();
+            while (acceptAny({"⊕", "^"})) {
+                left = add(FormulaOp::XOR, left, parseAnd());
+            }
+            return left;
+        }
+
+        int parseAnd() {
+            int left = parseUnary();
+            while (acceptAny({"∧", "&", "*"})) {
+                left = add(FormulaOp::AND, left, parseUnary());
+            }
+            return left;
+        }
+
+        int parseUnary() {
+            if (acceptAny({"¬", "!", "~"})) {
+                return add(FormulaOp::NOT, parseUnary(), -1);
+            }
+            return parsePrimary();
+        }
+
+        int parsePrimary() {
+            if (accept("(")) {
+                int inner = parseEquiv();
+                if (!accept(")")) {
+                    fail("Ожидается ')'");
+                }
+                return inner;
+            }
+            if (accept("0")) return leaf(FormulaOp::CONST, 0);
+            if (accept("1")) return leaf(FormulaOp::CONST, 1);
+
+            skipSpaces();
+            if (pos >= text.size() || !isNameStart(text[pos])) {
+                fail(pos >= text.size() ? "Неожиданный конец формулы" : "Ожидается переменная");
+            }
+            size_t start = pos;
+            while (pos < text.size() && isNameChar(text[pos])) {
+                ++pos;
+            }
+            std::string name = text.substr(start, pos - start);
+
+            auto it = names.find(name);
+            if (it == names.end()) {
+                it = names.emplace(name, static_cast<int>(formula.variables.size())).first;
+                formula.variables.push_back(name);
+            }
+            return leaf(FormulaOp::VAR, it->second);
+        }
+
+    public:
+        Parser(Formula& f, const std::string& s) : formula(f), text(s) {}
+
+        int parse() {
+            int result = parseEquiv();
+            skipSpaces();
+            if (pos != text.size()) {
+                fail("Лишние символы");
+            }
+            return result;
+        }
+    };
+
+    // Полином как отсортированный список масок мономов (бит n-1-j - x_{j+1})
+    static std::vector<uint64_t> addPolynomials(const std::vector<uint64_t>& a,
+                                                const std::vector<uint64_t>& b) {
+        std::vector<uint64_t> result;
+        std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                      std::back_inserter(result));
+        return result;
+    }
+
+    static std::vector<uint64_t> multiplyPolynomials(const std::vector<uint64_t>& a,
+                                                     const std::vector<uint64_t>& b) {
+        if (a.size() * b.size() > MAX_MONOMIALS) {
+            throw std::length_error("Полином Жегалкина слишком велик");
+        }
+        std::vector<uint64_t> products;
+        products.reserve(a.size() * b.size());
+        for (uint64_t x : a) {
+            for (uint64_t y : b) {
+                products.push_back(x | y);
+            }
+        }
+        std::sort(products.begin(), products.end());
+
+        // одинаковые мономы взаимно уничтожаются попарно
+        std::vector<uint64_t> result;
+        for (size_t i = 0; i < products.size();) {
+            size_t j = i;
+            while (j < products.size() && products[j] == products[i]) ++j;
+            if ((j - i) % 2 == 1) result.push_back(products[i]);
+            i = j;
+        }
+        return result;
+    }
+
+public:
+    static Formula parse(const std::string& text) {
+        Formula formula;
+        formula.root = Parser(formula, text).parse();
+        return formula;
+    }
+
+    int getNumVars() const { return static_cast<int>(variables.size()); }
+    const std::vector<std::string>& getVariables() const { return variables; }
+    const std::vector<FormulaNode>& getNodes() const { return nodes; }
+    int getRoot() const { return root; }
+
+    // Компиляция в БДР менеджера с не менее чем getNumVars() переменными.
+    // Промежуточные результаты удерживаются через addRef, поэтому между
+    // операциями допустима автоматическая перестановка переменных.
+    // Возвращённый корень удерживается одной внешней ссылкой.
+    uint32_t toBDD(BDDManager& manager) const {
+        if (manager.getNumVars() < getNumVars()) {
+            throw std::invalid_argument("В менеджере БДР меньше переменных, чем в формуле");
+        }
+
+        std::vector<uint32_t> results(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const FormulaNode& node = nodes[i];
+            uint32_t a = node.left >= 0 ? results[node.left] : BDDManager::FALSE_NODE;
+            uint32_t b = node.right >= 0 ? results[node.right] : BDDManager::FALSE_NODE;
+
+            uint32_t result;
+            switch (node.op) {
+                case FormulaOp::CONST:
+                    result = node.value ? BDDManager::TRUE_NODE : BDDManager::FALSE_NODE;
+                    break;
+                case FormulaOp::VAR:
+                    result = manager.variable(node.value);
+                    break;
+                case FormulaOp::NOT:
+                    result = manager.negate(a);
+                    break;
+                case FormulaOp::AND:
+                    result = manager.apply(BDDOp::AND, a, b);
+                    break;
+                case FormulaOp::OR:
+                    result = manager.apply(BDDOp::OR, a, b);
+                    break;
+                case FormulaOp::XOR:
+                    result = manager.apply(BDDOp::XOR, a, b);
+                    break;
+                case FormulaOp::IMPLIES:
+                    result = manager.apply(BDDOp::IMPLIES, a, b);
+                    break;
+                default:
+                    result = manager.apply(BDDOp::EQUIV, a, b);
+                    break;
+            }
+
+            // у каждого узла дерева один родитель: операнды больше не нужны
+            results[i] = manager.addRef(result);
+            if (node.left >= 0) manager.release(a);
+            if (node.right >= 0) manager.release(b);
+            manager.reorderIfNeeded();
+        }
+        return results[root];
+    }
+
+    // Мономы полинома Жегалкина в кодировке ZhegalkinPolynomial::getMonomials.
+    // Число мономов может расти экспоненциально (x1 ∨ ... ∨ xn даёт 2^n - 1),
+    // поэтому при превышении MAX_MONOMIALS бросается std::length_error.
+    std::vector<uint64_t> toANF() const {
+        int n = getNumVars();
+        if (n > 64) {
+            throw std::length_error("Для полинома Жегалкина не более 64 переменных");
+        }
+
+        const std::vector<uint64_t> one = {0};
+        std::vector<std::vector<uint64_t>> results(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const FormulaNode& node = nodes[i];
+            std::vector<uint64_t> a, b;
+            if (node.left >= 0) a.swap(results[node.left]);
+            if (node.right >= 0) b.swap(results[node.right]);
+
+            std::vector<uint64_t>& result = results[i];
+            switch (node.op) {
+                case FormulaOp::CONST:
+                    if (node.value) result = one;
+                    break;
+                case FormulaOp::VAR:
+                    result = {1ULL << (n - 1 - node.value)};
+                    break;
+                case FormulaOp::NOT:
+                    result = addPolynomials(a, one);
+                    break;
+                case FormulaOp::AND:
+                    result = multiplyPolynomials(a, b);
+                    break;
+                case FormulaOp::OR:  // a ⊕ b ⊕ ab
+                    result = addPolynomials(addPolynomials(a, b), multiplyPolynomials(a, b));
+                    break;
+                case FormulaOp::XOR:
+                    result = addPolynomials(a, b);
+                    break;
+                case FormulaOp::IMPLIES:  // 1 ⊕ a ⊕ ab
+                    result = addPolynomials(addPolynomials(one, a), multiplyPolynomials(a, b));
+                    break;
+                default:  // 1 ⊕ a ⊕ b
+                    result = addPolynomials(addPolynomials(one, a), b);
+                    break;
+            }
+        }
+        return results[root];
+    }
+};
+
+// Загрузка функции из формулы в меню
+class FormulaLoader : public CliUI {
+private:
+    // до этого числа переменных формула заменяет текущую функцию
+    static constexpr int MAX_TABLE_VARS = 16;
+
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+public:
+    // true, если func заменена функцией формулы
+    bool interactiveLoad(BDD& func) {
+        printHeader("ЗАГРУЗКА ФОРМУЛЫ");
+
+        std::cout << "Операции: ¬ (!, ~), ∧ (&, *), ⊕ (^), ∨ (|), → (->), ≡ (<->, =)\n";
+        std::cout << "Формула: ";
+        std::string text;
+        std::cin.ignore(10000, '\n');
+        std::getline(std::cin, text);
+
+        try {
+            Formula formula = Formula::parse(text);
+            int n = formula.getNumVars();
+
+            std::cout << "\nПеременных: " << n << "\n";
+            for (int j = 0; j < n; ++j) {
+                std::cout << "  x" << (j + 1) << " = " << formula.getVariables()[j] << "\n";
+            }
+
+            Clock::time_point start = Clock::now();
+            BDDManager manager(n);
+            manager.setAutoReorder(ReorderMethod::SIFTING);
+            uint32_t root = formula.toBDD(manager);
+            double bddMs = elapsedMs(start);
+            std::cout << "Узлов БДР: " << manager.countNodes(root)
+                      << " (" << std::fixed << std::setprecision(3) << bddMs << " мс)\n";
+            std::cout << "Выполняющих наборов: " << SatCounter(manager, root).count().toString() << "\n";
+            std::cout << (root == BDDManager::FALSE_NODE ? "Формула невыполнима\n"
+                          : root == BDDManager::TRUE_NODE ? "Формула тождественно истинна\n"
+                          : "Формула выполнима\n");
+
+            try {
+                start = Clock::now();
+                size_t monomials = formula.toANF().size();
+                std::cout << "Мономов полинома Жегалкина: " << monomials
+                          << " (" << std::fixed << std::setprecision(3) << elapsedMs(start) << " мс)\n";
+            } catch (const std::length_error& e) {
+                std::cout << "Полином Жегалкина не построен: " << e.what() << "\n";
+            }
+
+            if (n == 0 || n > MAX_TABLE_VARS) {
+                std::cout << "Текущая функция не изменена (таблица истинности строится для 1.."
+                          << MAX_TABLE_VARS << " переменных)\n";
+                return false;
+            }
+            func = BDD(CompactBDD(manager, root).toBitTable());
+            std::cout << "Формула загружена как текущая функция\n";
+            return true;
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Ошибка: " << e.what() << "\n";
+            return false;
+        }
+    }
+};
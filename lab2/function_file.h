@@ -0,0 +1,576 @@
+#pragma once
+#include "bdd.h"
+#include "bdd_function.h"
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+// Строка файла без комментария '#' и пробелов по краям
+inline std::string trimLine(const std::string& line) {
+    size_t end = line.find('#');
+    if (end == std::string::npos) end = line.size();
+    size_t begin = 0;
+    while (begin < end && std::isspace(static_cast<unsigned char>(line[begin]))) ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(line[end - 1]))) --end;
+    return line.substr(begin, end - begin);
+}
+
+// Потоковое чтение Berkeley PLA.
+// Заголовок (.i, .o, .type, .ilb, .ob, .p) читается в конструкторе,
+// затем кубы выдаются по одному через next, без хранения всего файла.
+// Вход куба - символы 0, 1, '-'; выход - 1 (или 4) для куба единиц
+// функции. Безразличные наборы (.type fd/fr) считаются нулями.
+class PLAReader {
+private:
+    // .o задаёт размер массива выходов в readAllBDDs и длину строки куба,
+    // поэтому число из непроверенного файла ограничено
+    static constexpr int MAX_OUTPUTS = 1 << 16;
+
+    std::istream& in;
+    int numInputs = -1;
+    int numOutputs = 1;
+    size_t lineNumber = 0;
+    std::string pending;  // первая строка кубов, прочитанная с заголовком
+    bool finished = false;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("PLA, строка " + std::to_string(lineNumber) + ": " + message);
+    }
+
+    bool readLine(std::string& line) {
+        std::string raw;
+        while (!finished && std::getline(in, raw)) {
+            ++lineNumber;
+            line = trimLine(raw);
+            if (line == ".e" || line == ".end") {
+                finished = true;
+            } else if (!line.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    explicit PLAReader(std::istream& input) : in(input) {
+        std::string line;
+        while (readLine(line)) {
+            if (line[0] != '.') {
+                pending = line;
+                break;
+            }
+            std::istringstream directive(line);
+            std::string name;
+            directive >> name;
+            if (name == ".i") {
+                directive >> numInputs;
+            } else if (name == ".o") {
+                directive >> numOutputs;
+            } else {
+                continue;  // .type, .ilb, .ob, .p и прочие не влияют на разбор
+            }
+            if (!directive) fail("ожидается число после " + name);
+        }
+
+        if (numInputs < 0) fail("нет директивы .i");
+        if (numInputs > 64 || numOutputs < 1 || numOutputs > MAX_OUTPUTS) {
+            fail("недопустимое число входов или выходов");
+        }
+    }
+
+    int getNumInputs() const { return numInputs; }
+    int getNumOutputs() const { return numOutputs; }
+
+    // Следующий куб и строка его выходов; false в конце файла
+    bool next(Cube& cube, std::string& outputs) {
+        std::string line;
+        if (!pending.empty()) {
+            line.swap(pending);
+        } else if (!readLine(line)) {
+            return false;
+        }
+
+        std::string symbols;
+        for (char c : line) {
+            if (!std::isspace(static_cast<unsigned char>(c))) symbols += c;
+        }
+        if (symbols.size() != static_cast<size_t>(numInputs + numOutputs)) {
+            fail("ожидается " + std::to_string(numInputs) + " входов и "
+                 + std::to_string(numOutputs) + " выходов");
+        }
+
+        cube = Cube{};
+        for (int j = 0; j < numInputs; ++j) {
+            uint64_t bit = 1ULL << (numInputs - 1 - j);
+            switch (symbols[j]) {
+                case '1': cube.value |= bit; cube.care |= bit; break;
+                case '0': cube.care |= bit; break;
+                case '-': case '2': break;
+                default: fail(std::string("недопустимый символ входа '") + symbols[j] + "'");
+            }
+        }
+        outputs = symbols.substr(numInputs);
+        return true;
+    }
+
+    static bool inOnSet(const std::string& outputs, int output) {
+        return outputs[output] == '1' || outputs[output] == '4';
+    }
+
+    // Упакованная таблица выхода output: кубы заливаются прямо в слова
+    BitTable readTable(int output) {
+        if (numInputs > BitTable::MAX_VARS) fail("слишком много входов для таблицы истинности");
+        BitTable table(numInputs);
+        Cube cube;
+        std::string outputs;
+        while (next(cube, outputs)) {
+            if (inOnSet(outputs, output)) table.setCube(cube.value, cube.care);
+        }
+        return table;
+    }
+
+    // БДР выхода output как дизъюнкция кубов; корень удерживается addRef
+    uint32_t readBDD(BDDManager& manager, int output) {
+        uint32_t result = manager.addRef(BDDManager::FALSE_NODE);
+        Cube cube;
+        std::string outputs;
+        while (next(cube, outputs)) {
+            if (!inOnSet(outputs, output)) continue;
+            uint32_t sum = manager.apply(BDDOp::OR, result, manager.cube(cube.value, cube.care));
+            manager.addRef(sum);
+            manager.release(result);
+            result = sum;
+            manager.reorderIfNeeded();
+        }
+        return result;
+    }
+
+    // БДР всех выходов в одном менеджере за один проход по кубам:
+    // подграфы, общие для нескольких выходов, хранятся один раз
+    std::vector<BDDFunction> readAllBDDs(BDDManager& manager) {
+        std::vector<BDDFunction> result(numOutputs, BDDFunction::constant(manager, false));
+        Cube cube;
+        std::string outputs;
+        while (next(cube, outputs)) {
+            BDDFunction term(manager, manager.cube(cube.value, cube.care));
+            for (int output = 0; output < numOutputs; ++output) {
+                if (inOnSet(outputs, output)) result[output] |= term;
+            }
+            manager.reorderIfNeeded();
+        }
+        return result;
+    }
+};
+
+// Подмножество BLIF: одна модель из .inputs, .outputs и .names
+// (однострочные покрытия кубами, выход покрытия 1 - единицы, 0 - нули).
+// Порядок .names произвольный; латчи и подсхемы не поддерживаются.
+class BLIFReader {
+private:
+    struct Gate {
+        std::vector<std::string> signals;  // входы, последний - выход
+        std::vector<std::string> cover;
+        size_t line;
+    };
+
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    std::vector<Gate> gates;
+    std::map<std::string, size_t> driver;  // сигнал -> вентиль
+
+    [[noreturn]] static void fail(size_t line, const std::string& message) {
+        throw std::invalid_argument("BLIF, строка " + std::to_string(line) + ": " + message);
+    }
+
+    static std::vector<std::string> split(const std::string& line) {
+        std::istringstream stream(line);
+        std::vector<std::string> tokens;
+        std::string token;
+        while (stream >> token) tokens.push_back(token);
+        return tokens;
+    }
+
+    // Узел вентиля: дизъюнкция кубов покрытия по узлам его входов
+    uint32_t gateNode(BDDManager& manager, const Gate& gate,
+                      const std::vector<uint32_t>& operands) const {
+        size_t k = gate.signals.size() - 1;
+        uint32_t sum = BDDManager::FALSE_NODE;
+        char polarity = 0;
+
+        for (const std::string& row : gate.cover) {
+            std::vector<std::string> parts = split(row);
+            std::string literals = k > 0 ? parts[0] : "";
+            char value = parts.back()[0];
+            if (parts.size() != (k > 0 ? 2u : 1u) || literals.size() != k
+                || parts.back().size() != 1 || (value != '0' && value != '1')) {
+                fail(gate.line, "неверная строка покрытия '" + row + "'");
+            }
+            if (polarity != 0 && polarity != value) {
+                fail(gate.line, "покрытие смешивает единицы и нули");
+            }
+            polarity = value;
+
+            uint32_t product = BDDManager::TRUE_NODE;
+            for (size_t i = 0; i < k; ++i) {
+                if (literals[i] == '-') continue;
+                if (literals[i] != '0' && literals[i] != '1') {
+                    fail(gate.line, "неверный литерал '" + std::string(1, literals[i]) + "'");
+                }
+                uint32_t literal = literals[i] == '1' ? operands[i] : manager.negate(operands[i]);
+                product = manager.apply(BDDOp::AND, product, literal);
+            }
+            sum = manager.apply(BDDOp::OR, sum, product);
+        }
+        return polarity == '0' ? manager.negate(sum) : sum;
+    }
+
+public:
+    explicit BLIFReader(std::istream& in) {
+        std::string raw, line;
+        size_t lineNumber = 0, start = 0;
+        Gate* current = nullptr;
+
+        while (std::getline(in, raw)) {
+            ++lineNumber;
+            if (line.empty()) start = lineNumber;
+            line += trimLine(raw);
+            if (!line.empty() && line.back() == '\\') {
+                line.pop_back();
+                line += ' ';
+                continue;
+            }
+            if (line.empty()) continue;
+
+            std::vector<std::string> tokens = split(line);
+            std::string text = line;
+            line.clear();
+
+            if (tokens[0][0] != '.') {
+                if (!current) fail(start, "строка покрытия вне .names");
+                current->cover.push_back(text);
+                continue;
+            }
+
+            current = nullptr;
+            const std::string& name = tokens[0];
+            if (name == ".inputs") {
+                inputs.insert(inputs.end(), tokens.begin() + 1, tokens.end());
+            } else if (name == ".outputs") {
+                outputs.insert(outputs.end(), tokens.begin() + 1, tokens.end());
+            } else if (name == ".names") {
+                if (tokens.size() < 2) fail(start, ".names без сигналов");
+                const std::string& output = tokens.back();
+                if (!driver.emplace(output, gates.size()).second) {
+                    fail(start, "сигнал " + output + " определён дважды");
+                }
+                gates.push_back({std::vector<std::string>(tokens.begin() + 1, tokens.end()), {}, start});
+                current = &gates.back();
+            } else if (name == ".end") {
+                break;
+            } else if (name != ".model") {
+                fail(start, "директива " + name + " не поддерживается");
+            }
+        }
+
+        if (inputs.size() > 64) fail(lineNumber, "более 64 входов");
+        if (outputs.empty()) fail(lineNumber, "нет директивы .outputs");
+    }
+
+    const std::vector<std::string>& getInputs() const { return inputs; }
+    const std::vector<std::string>& getOutputs() const { return outputs; }
+
+    // БДР выхода output над входами в порядке .inputs (первый - x1).
+    // Вентили строятся от выхода вглубь с запоминанием; все готовые
+    // сигналы удерживаются addRef, поэтому после каждого вентиля возможна
+    // автоматическая перестановка. Корень удерживается одной ссылкой.
+    uint32_t readBDD(BDDManager& manager, int output) const {
+        if (manager.getNumVars() < static_cast<int>(inputs.size())) {
+            throw std::invalid_argument("В менеджере БДР меньше переменных, чем входов схемы");
+        }
+
+        std::map<std::string, uint32_t> value;
+        for (size_t j = 0; j < inputs.size(); ++j) {
+            value[inputs[j]] = manager.addRef(manager.variable(static_cast<int>(j)));
+        }
+
+        // обход в глубину без рекурсии: глубина схем бывает большой
+        std::vector<char> state(gates.size(), 0);  // 1 - в стеке, 2 - готов
+        std::vector<std::string> stack = {outputs[output]};
+        while (!stack.empty()) {
+            std::string signal = stack.back();
+            if (value.count(signal)) {
+                stack.pop_back();
+                continue;
+            }
+            auto it = driver.find(signal);
+            if (it == driver.end()) {
+                throw std::invalid_argument("BLIF: сигнал " + signal + " нигде не определён");
+            }
+            const Gate& gate = gates[it->second];
+
+            if (state[it->second] == 0) {
+                state[it->second] = 1;
+                for (size_t i = 0; i + 1 < gate.signals.size(); ++i) {
+                    if (!value.count(gate.signals[i])) stack.push_back(gate.signals[i]);
+                }
+                continue;
+            }
+
+            std::vector<uint32_t> operands;
+            for (size_t i = 0; i + 1 < gate.signals.size(); ++i) {
+                auto operand = value.find(gate.signals[i]);
+                if (operand == value.end()) fail(gate.line, "цикл через сигнал " + signal);
+                operands.push_back(operand->second);
+            }
+            value[signal] = manager.addRef(gateNode(manager, gate, operands));
+            state[it->second] = 2;
+            stack.pop_back();
+            manager.reorderIfNeeded();
+        }
+
+        uint32_t root = manager.addRef(value[outputs[output]]);
+        for (const auto& entry : value) {
+            manager.release(entry.second);
+        }
+        return root;
+    }
+};
+
+// Таблица истинности как шестнадцатеричное число: бит r - значение на
+// строке r, последняя цифра - строки 0..3 (так пишут таблицы ABC).
+// Число переменных определяется по числу цифр 2^(n-2), поэтому n >= 2:
+// одна цифра - функция двух переменных, функцию одной переменной
+// нужно записать как функцию двух.
+class HexTable {
+private:
+    static constexpr size_t CHUNK_SIZE = 1 << 16;
+    // 2^(MAX_VARS - 2) цифр - самая большая допустимая таблица
+    static constexpr uint64_t MAX_DIGITS = uint64_t(1) << (BitTable::MAX_VARS - 2);
+
+    static int digitValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // Порядок 16 цифр слова на обратный
+    static uint64_t reverseNibbles(uint64_t w) {
+        w = __builtin_bswap64(w);
+        return ((w >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((w & 0x0f0f0f0f0f0f0f0fULL) << 4);
+    }
+
+public:
+    // Потоковый разбор: цифры упаковываются в слова по 16 по мере чтения
+    // блоков (первая цифра - в младшие биты первого слова). Когда число
+    // цифр, а с ним и n, известно, порядок цифр обращается на месте и
+    // слова передаются в таблицу без копирования текста.
+    static BitTable read(std::istream& in) {
+        std::vector<uint64_t> words;
+        uint64_t count = 0;
+        bool leadingZero = false;  // прочитан только '0', возможно начало "0x"
+        char buffer[CHUNK_SIZE];
+
+        while (in) {
+            in.read(buffer, CHUNK_SIZE);
+            std::streamsize got = in.gcount();
+            for (std::streamsize i = 0; i < got; ++i) {
+                char c = buffer[i];
+                if (std::isspace(static_cast<unsigned char>(c))) {
+                    leadingZero = false;
+                    continue;
+                }
+                if (leadingZero && (c == 'x' || c == 'X')) {
+                    words.clear();
+                    count = 0;
+                    leadingZero = false;
+                    continue;
+                }
+                int digit = digitValue(c);
+                if (digit < 0) {
+                    throw std::invalid_argument("Недопустимый символ в шестнадцатеричной таблице");
+                }
+                if (count == MAX_DIGITS) {
+                    throw std::invalid_argument("Слишком большая шестнадцатеричная таблица");
+                }
+                leadingZero = count == 0 && digit == 0;
+                if ((count & 15) == 0) words.push_back(0);
+                words.back() |= static_cast<uint64_t>(digit) << (4 * (count & 15));
+                ++count;
+            }
+        }
+
+        if (count == 0 || (count & (count - 1)) != 0) {
+            throw std::invalid_argument("Число цифр таблицы должно быть степенью двойки");
+        }
+        int n = 2 + __builtin_ctzll(count);
+
+        // последняя цифра текста - строки 0..3: обращаются и порядок слов,
+        // и порядок цифр в словах; неполное (единственное) слово сдвигается
+        std::reverse(words.begin(), words.end());
+        for (uint64_t& w : words) {
+            w = reverseNibbles(w);
+        }
+        if (count < 16) {
+            words[0] >>= 4 * (16 - count);
+        }
+        return BitTable::fromWords(n, std::move(words));
+    }
+};
+
+// Загрузка функции из файла в меню
+class FunctionFileLoader : public CliUI {
+private:
+    // до этого числа входов функция из файла заменяет текущую
+    static constexpr int MAX_TABLE_VARS = 24;
+
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    int chooseOutput(int count) const {
+        if (count == 1) return 0;
+        return getUserInput("Номер выхода (1.." + std::to_string(count) + "): ", 1, count) - 1;
+    }
+
+    void reportBDD(const BDDManager& manager, uint32_t root) const {
+        std::cout << "Узлов БДР: " << manager.countNodes(root) << "\n";
+    }
+
+public:
+    // Все выходы PLA или BLIF в одном общем менеджере: сравнение суммы
+    // размеров БДР выходов с числом узлов общего хранилища
+    void interactiveSharedLoad() {
+        printHeader("ВСЕ ВЫХОДЫ СХЕМЫ В ОБЩЕМ МЕНЕДЖЕРЕ БДР");
+
+        std::cout << "1. Berkeley PLA\n";
+        std::cout << "2. BLIF\n";
+        int format = getUserInput("Формат: ", 1, 2);
+
+        std::cout << "Путь к файлу: ";
+        std::string path;
+        std::cin.ignore(10000, '\n');
+        std::getline(std::cin, path);
+
+        std::ifstream file(path);
+        if (!file) {
+            std::cout << "Не удалось открыть файл " << path << "\n";
+            return;
+        }
+
+        try {
+            Clock::time_point start = Clock::now();
+            std::unique_ptr<BDDManager> manager;
+            std::vector<BDDFunction> functions;
+
+            if (format == 1) {
+                PLAReader reader(file);
+                manager = std::make_unique<BDDManager>(reader.getNumInputs());
+                manager->setAutoReorder(ReorderMethod::SIFTING);
+                functions = reader.readAllBDDs(*manager);
+            } else {
+                BLIFReader reader(file);
+                manager = std::make_unique<BDDManager>(static_cast<int>(reader.getInputs().size()));
+                manager->setAutoReorder(ReorderMethod::SIFTING);
+                for (size_t output = 0; output < reader.getOutputs().size(); ++output) {
+                    uint32_t root = reader.readBDD(*manager, static_cast<int>(output));
+                    functions.emplace_back(*manager, root);
+                    manager->release(root);
+                }
+            }
+            double ms = elapsedMs(start);
+
+            size_t separate = 0;
+            std::vector<uint32_t> roots;
+            for (size_t k = 0; k < functions.size(); ++k) {
+                size_t count = functions[k].nodeCount();
+                separate += count;
+                roots.push_back(functions[k].getRoot());
+                std::cout << "  выход " << (k + 1) << ": " << count << " узлов\n";
+            }
+            printSeparator();
+
+            size_t freed = manager->collectGarbage();
+            std::cout << "Сумма размеров отдельных БДР: " << separate << "\n";
+            std::cout << "Узлов в общем хранилище: " << manager->countNodes(roots)
+                      << " (освобождено сборкой мусора: " << freed << ")\n";
+            std::cout << "Время построения: " << std::fixed << std::setprecision(3) << ms << " мс\n";
+        } catch (const std::exception& e) {
+            std::cout << "Ошибка: " << e.what() << "\n";
+        }
+    }
+
+    // true, если func заменена функцией из файла
+    bool interactiveLoad(BDD& func) {
+        printHeader("ЗАГРУЗКА ФУНКЦИИ ИЗ ФАЙЛА");
+
+        std::cout << "1. Berkeley PLA\n";
+        std::cout << "2. BLIF\n";
+        std::cout << "3. Шестнадцатеричная таблица истинности\n";
+        int format = getUserInput("Формат: ", 1, 3);
+
+        std::cout << "Путь к файлу: ";
+        std::string path;
+        std::cin.ignore(10000, '\n');
+        std::getline(std::cin, path);
+
+        std::ifstream file(path);
+        if (!file) {
+            std::cout << "Не удалось открыть файл " << path << "\n";
+            return false;
+        }
+
+        try {
+            Clock::time_point start;
+            BitTable table;
+            int n;
+
+            if (format == 1) {
+                PLAReader reader(file);
+                n = reader.getNumInputs();
+                int output = chooseOutput(reader.getNumOutputs());
+                start = Clock::now();
+                if (n <= MAX_TABLE_VARS) {
+                    table = reader.readTable(output);
+                } else {
+                    BDDManager manager(n);
+                    manager.setAutoReorder(ReorderMethod::SIFTING);
+                    reportBDD(manager, reader.readBDD(manager, output));
+                }
+            } else if (format == 2) {
+                BLIFReader reader(file);
+                n = static_cast<int>(reader.getInputs().size());
+                int output = chooseOutput(static_cast<int>(reader.getOutputs().size()));
+                start = Clock::now();
+                BDDManager manager(n);
+                manager.setAutoReorder(ReorderMethod::SIFTING);
+                uint32_t root = reader.readBDD(manager, output);
+                reportBDD(manager, root);
+                if (n <= MAX_TABLE_VARS) table = CompactBDD(manager, root).toBitTable();
+            } else {
+                start = Clock::now();
+                table = HexTable::read(file);
+                n = table.getNumVars();
+            }
+
+            std::cout << "Входов: " << n << ", время чтения: " << std::fixed
+                      << std::setprecision(3) << elapsedMs(start) << " мс\n";
+            if (n == 0 || n > MAX_TABLE_VARS) {
+                std::cout << "Текущая функция не изменена (таблица истинности строится для 1.."
+                          << MAX_TABLE_VARS << " входов)\n";
+                return false;
+            }
+            std::cout << "Единиц в таблице: " << table.weight() << "\n";
+            func = BDD(table);
+            std::cout << "Функция загружена как текущая\n";
+            return true;
+        } catch (const std::exception& e) {
+            std::cout << "Ошибка: " << e.what() << "\n";
+            return false;
+        }
+    }
+};
@@ -1,4 +1,8 @@
-#include "bdd.h"
+#include "bdd_io.h"
+#include "equivalence.h"
+#include "formula.h"
+#include "function_file.h"
+#include "properties.h"
 
 int main() {
     std::vector<int> functionVector = {
@@ -9,6 +13,11 @@ int main() {
     };
 
     BDD func(4, functionVector);
+    EquivalenceChecker checker;
+    FormulaLoader loader;
+    FunctionFileLoader fileLoader;
+    BDDFileUI bddFiles;
+    PropertyAnalyzer analyzer;
 
     while (true) {
         std::cout << "\n";
@@ -22,6 +31,21 @@ int main() {
         std::cout << "║  5. БДР                                        ║\n";
         std::cout << "║  6. Вычислить по полиному Жегалкина            ║\n";
         std::cout << "║  7. Вычислить по БДР                           ║\n";
+        std::cout << "║  8. Переупорядочить переменные БДР             ║\n";
+        std::cout << "║  9. Проверить согласованность представлений    ║\n";
+        std::cout << "║ 10. Бенчмарк вычисления                        ║\n";
+        std::cout << "║ 11. Минимальная ДНФ                            ║\n";
+        std::cout << "║ 12. Минимальная КНФ                            ║\n";
+        std::cout << "║ 13. Загрузить формулу                          ║\n";
+        std::cout << "║ 14. Загрузить функцию из файла (PLA/BLIF/hex)  ║\n";
+        std::cout << "║ 15. Свойства функции (классы Поста)            ║\n";
+        std::cout << "║ 16. Спектр Уолша-Адамара и нелинейность        ║\n";
+        std::cout << "║ 17. Выполняющие наборы (#SAT)                  ║\n";
+        std::cout << "║ 18. Все выходы схемы в общем менеджере БДР     ║\n";
+        std::cout << "║ 19. Бенчмарк параллельного apply               ║\n";
+        std::cout << "║ 20. Экспорт и загрузка БДР (DOT/двоичный)      ║\n";
+        std::cout << "║ 21. ДРНП мономов полинома Жегалкина            ║\n";
+        std::cout << "║ 22. Полином Жегалкина и БДР без таблицы        ║\n";
         std::cout << "║  0. Выход                                      ║\n";
         std::cout << "╚════════════════════════════════════════════════╝\n";
         std::cout << "Выбор: ";
@@ -51,6 +75,51 @@ int main() {
             case 7:
                 func.interactiveEvaluateBDD();
                 break;
+            case 8:
+                func.reorderBDD();
+                break;
+            case 9:
+                checker.interactiveCheck(func);
+                break;
+            case 10:
+                checker.interactiveBenchmark();
+                break;
+            case 11:
+                func.displayMinimalDNF();
+                break;
+            case 12:
+                func.displayMinimalCNF();
+                break;
+            case 13:
+                loader.interactiveLoad(func);
+                break;
+            case 14:
+                fileLoader.interactiveLoad(func);
+                break;
+            case 15:
+                analyzer.displayProperties(func);
+                break;
+            case 16:
+                func.displayWalshSpectrum();
+                break;
+            case 17:
+                func.displaySatisfying();
+                break;
+            case 18:
+                fileLoader.interactiveSharedLoad();
+                break;
+            case 19:
+                checker.interactiveApplyBenchmark();
+                break;
+            case 20:
+                bddFiles.interactiveRun(func);
+                break;
+            case 21:
+                func.displayZDD();
+                break;
+            case 22:
+                func.displayDirectConversion();
+                break;
             case 0:
                 std::cout << "До свидания!\n";
                 return 0;
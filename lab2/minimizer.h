@@ -0,0 +1,359 @@
+#pragma once
+#include <ostream>
+#include "bit_table.h"
+#include "bdd_manager.h"
+
+// Куб (конъюнкция литералов) в той же нумерации битов, что и строки
+// таблицы истинности: бит (n - 1 - j) относится к x(j+1). Переменная
+// входит в куб, если её бит установлен в care; value задаёт знак литерала.
+struct Cube {
+    uint64_t value = 0;
+    uint64_t care = 0;
+
+    int literals() const { return __builtin_popcountll(care); }
+};
+
+// Потоковый вывод ДНФ и КНФ прямо в ostream, без промежуточных строк.
+// В режиме КНФ куб записывается как дизъюнкция отрицаний своих литералов:
+// так куб нулей функции превращается в её дизъюнкт.
+class NormalFormWriter {
+private:
+    std::ostream& out;
+    int numVars;
+    bool conjunctive;
+    bool first = true;
+
+public:
+    NormalFormWriter(std::ostream& os, int n, bool cnf) : out(os), numVars(n), conjunctive(cnf) {}
+
+    void term(const Cube& cube) {
+        out << (first ? "" : conjunctive ? " ∧ " : " ∨ ");
+        first = false;
+
+        if (cube.care == 0) {
+            // пустой куб - тождественная 1, пустой дизъюнкт - тождественный 0
+            out << (conjunctive ? "0" : "1");
+            return;
+        }
+
+        out << "(";
+        bool firstLiteral = true;
+        for (int j = 0; j < numVars; ++j) {
+            uint64_t bit = 1ULL << (numVars - 1 - j);
+            if (!(cube.care & bit)) continue;
+
+            out << (firstLiteral ? "" : conjunctive ? "∨" : "∧");
+            firstLiteral = false;
+
+            bool positive = (cube.value & bit) != 0;
+            out << (positive != conjunctive ? "x" : "¬x") << (j + 1);
+        }
+        out << ")";
+    }
+
+    // Пустая ДНФ - 0, пустая КНФ - 1
+    void finish() {
+        if (first) out << (conjunctive ? "1" : "0");
+    }
+};
+
+// Итог минимизации: покрытие единиц функции кубами
+struct MinimalForm {
+    std::vector<Cube> cubes;
+    bool exact = false;  // покрытие доказанно минимально
+
+    int literals() const {
+        int total = 0;
+        for (const Cube& cube : cubes) total += cube.literals();
+        return total;
+    }
+};
+
+// Минимизация ДНФ. До QM_MAX_VARS переменных - метод Квайна-Мак-Класки:
+// все простые импликанты строятся над битовыми таблицами, затем ищется
+// минимальное покрытие перебором с отсечениями (с ограничением числа шагов).
+// Для больших n - эвристика в духе Espresso над БДР: неизбыточное покрытие
+// Минато-Морреале, расширение кубов до простых и удаление избыточных.
+// Минимальная КНФ - это ДНФ отрицания, записанная дизъюнктами.
+class Minimizer {
+private:
+    static constexpr int QM_MAX_VARS = 12;
+    static constexpr size_t COVER_SEARCH_LIMIT = 200000;
+
+    // Сравнение покрытий: сначала по числу кубов, затем по числу литералов
+    static bool cheaper(size_t cubesA, int literalsA, size_t cubesB, int literalsB) {
+        return cubesA != cubesB ? cubesA < cubesB : literalsA < literalsB;
+    }
+
+    // --- Квайн - Мак-Класки ---
+
+    // Таблица, в которой строка r равна 1, если f = 1 на всех строках,
+    // отличающихся от r только переменной var
+    static BitTable forallVar(const BitTable& g, int var) {
+        return g.cofactor(var, false) & g.cofactor(var, true);
+    }
+
+    // g - f, проквантифицированная по всем переменным из dashes (в битах
+    // строк), zero - строки с нулевыми битами dashes: каждая единица
+    // g & zero задаёт импликант с прочерками dashes. Импликант прост, если
+    // ни одна из оставшихся переменных не даёт его расширить.
+    static void collectPrimes(const BitTable& g, const BitTable& zero, uint64_t dashes,
+                              int lowestFree, std::vector<Cube>& primes) {
+        int n = g.getNumVars();
+        uint64_t full = (1ULL << n) - 1;
+
+        std::vector<BitTable> expanded(n);
+        BitTable expandable(n);
+        for (int b = 0; b < n; ++b) {
+            if (dashes & (1ULL << b)) continue;
+            expanded[b] = forallVar(g, n - 1 - b);
+            expandable |= expanded[b];
+        }
+
+        BitTable own = g & zero & ~expandable;
+        const std::vector<uint64_t>& words = own.getWords();
+        for (size_t i = 0; i < words.size(); ++i) {
+            for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+                uint64_t row = (uint64_t(i) << 6) | __builtin_ctzll(w);
+                primes.push_back({row, full & ~dashes});
+            }
+        }
+
+        for (int b = lowestFree; b < n; ++b) {
+            if (dashes & (1ULL << b) || expanded[b].isZero()) continue;
+            BitTable nextZero = zero & ~BitTable::variable(n, n - 1 - b);
+            collectPrimes(expanded[b], nextZero, dashes | (1ULL << b), b + 1, primes);
+        }
+    }
+
+    static std::vector<Cube> primeImplicants(const BitTable& f) {
+        std::vector<Cube> primes;
+        if (!f.isZero()) {
+            collectPrimes(f, ~BitTable(f.getNumVars()), 0, 0, primes);
+        }
+        return primes;
+    }
+
+    // Поиск минимального покрытия единиц простыми импликантами: ветвление
+    // по непокрытой единице с наименьшим числом покрывающих импликантов
+    // (существенные импликанты выбираются этим правилом сразу)
+    class CoverSearch {
+    private:
+        const std::vector<Cube>& primes;
+        std::vector<std::vector<uint32_t>> primeCovers;    // единицы импликанта
+        std::vector<std::vector<uint32_t>> mintermPrimes;  // импликанты единицы
+        std::vector<uint32_t> coveredBy;
+        size_t uncovered;
+
+        std::vector<uint32_t> chosen;
+        int chosenLiterals = 0;
+        std::vector<uint32_t> best;
+        int bestLiterals = 0;
+        size_t steps = 0;
+
+        void choose(uint32_t p, int delta) {
+            for (uint32_t t : primeCovers[p]) {
+                if (delta > 0 && coveredBy[t]++ == 0) --uncovered;
+                if (delta < 0 && --coveredBy[t] == 0) ++uncovered;
+            }
+        }
+
+        void search() {
+            if (++steps > COVER_SEARCH_LIMIT) return;
+
+            if (uncovered == 0) {
+                if (best.empty() || cheaper(chosen.size(), chosenLiterals, best.size(), bestLiterals)) {
+                    best = chosen;
+                    bestLiterals = chosenLiterals;
+                }
+                return;
+            }
+            if (!best.empty() && chosen.size() + 1 > best.size()) return;
+
+            size_t target = 0, fewest = SIZE_MAX;
+            for (size_t t = 0; t < mintermPrimes.size(); ++t) {
+                if (coveredBy[t] == 0 && mintermPrimes[t].size() < fewest) {
+                    fewest = mintermPrimes[t].size();
+                    target = t;
+                }
+            }
+
+            std::vector<uint32_t> options = mintermPrimes[target];
+            std::sort(options.begin(), options.end(), [this](uint32_t a, uint32_t b) {
+                return primeCovers[a].size() > primeCovers[b].size();
+            });
+
+            for (uint32_t p : options) {
+                chosen.push_back(p);
+                chosenLiterals += primes[p].literals();
+                choose(p, 1);
+
+                search();
+
+                choose(p, -1);
+                chosenLiterals -= primes[p].literals();
+                chosen.pop_back();
+            }
+        }
+
+    public:
+        CoverSearch(const BitTable& f, const std::vector<Cube>& primeList) : primes(primeList) {
+            std::vector<uint32_t> mintermIndex(f.rows(), UINT32_MAX);
+            uint32_t count = 0;
+            for (size_t r = 0; r < f.rows(); ++r) {
+                if (f.get(r)) mintermIndex[r] = count++;
+            }
+
+            mintermPrimes.resize(count);
+            primeCovers.resize(primes.size());
+            for (uint32_t p = 0; p < primes.size(); ++p) {
+                uint64_t dashes = ~primes[p].care & (f.rows() - 1);
+                for (uint64_t s = dashes;; s = (s - 1) & dashes) {
+                    uint32_t t = mintermIndex[primes[p].value | s];
+                    primeCovers[p].push_back(t);
+                    mintermPrimes[t].push_back(p);
+                    if (s == 0) break;
+                }
+            }
+
+            coveredBy.assign(count, 0);
+            uncovered = count;
+        }
+
+        MinimalForm run() {
+            search();
+
+            MinimalForm result;
+            result.exact = steps <= COVER_SEARCH_LIMIT;
+            for (uint32_t p : best) {
+                result.cubes.push_back(primes[p]);
+            }
+            return result;
+        }
+    };
+
+    static MinimalForm quineMcCluskey(const BitTable& f) {
+        std::vector<Cube> primes = primeImplicants(f);
+        if (primes.empty()) {
+            return MinimalForm{{}, true};
+        }
+        return CoverSearch(f, primes).run();
+    }
+
+    // --- эвристика над БДР ---
+
+    static uint64_t rowBit(const BDDManager& manager, int var) {
+        return 1ULL << (manager.getNumVars() - 1 - var);
+    }
+
+    // Куб как БДР
+    static uint32_t cubeNode(BDDManager& manager, const Cube& cube) {
+        uint32_t result = BDDManager::TRUE_NODE;
+        for (int var = manager.getNumVars() - 1; var >= 0; --var) {
+            uint64_t bit = rowBit(manager, var);
+            if (!(cube.care & bit)) continue;
+            uint32_t literal = manager.variable(var);
+            if (!(cube.value & bit)) literal = manager.negate(literal);
+            result = manager.apply(BDDOp::AND, literal, result);
+        }
+        return result;
+    }
+
+    // Куб целиком лежит в g: ограничение g литералами куба тождественно 1
+    static bool cubeImplies(BDDManager& manager, const Cube& cube, uint32_t g) {
+        for (int var = 0; var < manager.getNumVars() && g != BDDManager::TRUE_NODE; ++var) {
+            uint64_t bit = rowBit(manager, var);
+            if (cube.care & bit) {
+                g = manager.restrict(g, var, (cube.value & bit) != 0);
+            }
+        }
+        return g == BDDManager::TRUE_NODE;
+    }
+
+    // Неизбыточное покрытие Минато-Морреале для L <= f <= U;
+    // возвращает БДР построенного покрытия
+    static uint32_t isop(BDDManager& manager, uint32_t lower, uint32_t upper,
+                         Cube prefix, std::vector<Cube>& cubes) {
+        if (lower == BDDManager::FALSE_NODE) {
+            return BDDManager::FALSE_NODE;
+        }
+        if (upper == BDDManager::TRUE_NODE) {
+            cubes.push_back(prefix);
+            return BDDManager::TRUE_NODE;
+        }
+
+        int lvl = std::min(manager.level(lower), manager.level(upper));
+        int var = manager.getOrder()[lvl];
+        uint64_t bit = rowBit(manager, var);
+
+        uint32_t l0 = manager.restrict(lower, var, false), l1 = manager.restrict(lower, var, true);
+        uint32_t u0 = manager.restrict(upper, var, false), u1 = manager.restrict(upper, var, true);
+
+        Cube negative{prefix.value, prefix.care | bit};
+        Cube positive{prefix.value | bit, prefix.care | bit};
+
+        uint32_t r0 = isop(manager, manager.apply(BDDOp::AND, l0, manager.negate(u1)), u0, negative, cubes);
+        uint32_t r1 = isop(manager, manager.apply(BDDOp::AND, l1, manager.negate(u0)), u1, positive, cubes);
+
+        uint32_t rest = manager.apply(BDDOp::OR,
+            manager.apply(BDDOp::AND, l0, manager.negate(r0)),
+            manager.apply(BDDOp::AND, l1, manager.negate(r1)));
+        uint32_t rStar = isop(manager, rest, manager.apply(BDDOp::AND, u0, u1), prefix, cubes);
+
+        return manager.ite(manager.variable(var),
+                           manager.apply(BDDOp::OR, r1, rStar),
+                           manager.apply(BDDOp::OR, r0, rStar));
+    }
+
+    static MinimalForm heuristic(const BitTable& f) {
+        BDDManager manager(f.getNumVars());
+        uint32_t g = manager.fromTruthTable(f);
+
+        std::vector<Cube> cubes;
+        isop(manager, g, g, Cube{}, cubes);
+
+        // расширение: литералы снимаются, пока куб остаётся импликантом
+        for (Cube& cube : cubes) {
+            for (int var = 0; var < f.getNumVars(); ++var) {
+                uint64_t bit = rowBit(manager, var);
+                if (!(cube.care & bit)) continue;
+                Cube wider{cube.value & ~bit, cube.care & ~bit};
+                if (cubeImplies(manager, wider, g)) cube = wider;
+            }
+        }
+
+        // удаление избыточных: куб лишний, если его покрывают оставшиеся;
+        // кубы с большим числом литералов проверяются первыми
+        std::sort(cubes.begin(), cubes.end(), [](const Cube& a, const Cube& b) {
+            return a.literals() > b.literals();
+        });
+
+        std::vector<uint32_t> suffix(cubes.size() + 1, BDDManager::FALSE_NODE);
+        for (size_t i = cubes.size(); i-- > 0;) {
+            suffix[i] = manager.apply(BDDOp::OR, cubeNode(manager, cubes[i]), suffix[i + 1]);
+        }
+
+        MinimalForm result;
+        uint32_t kept = BDDManager::FALSE_NODE;
+        for (size_t i = 0; i < cubes.size(); ++i) {
+            uint32_t others = manager.apply(BDDOp::OR, kept, suffix[i + 1]);
+            if (cubeImplies(manager, cubes[i], others)) continue;
+            result.cubes.push_back(cubes[i]);
+            kept = manager.apply(BDDOp::OR, kept, cubeNode(manager, cubes[i]));
+        }
+        return result;
+    }
+
+public:
+    static MinimalForm minimizeDNF(const BitTable& f) {
+        if (f.getNumVars() <= QM_MAX_VARS) {
+            return quineMcCluskey(f);
+        }
+        return heuristic(f);
+    }
+
+    // Кубы нулей функции; записываются дизъюнктами через NormalFormWriter
+    static MinimalForm minimizeCNF(const BitTable& f) {
+        return minimizeDNF(~f);
+    }
+};
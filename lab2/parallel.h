@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+// Число потоков для count независимых единиц работы: на каждый поток
+// приходится не меньше minPerThread единиц, мелкие задачи идут в одном потоке
+inline unsigned chooseThreads(size_t count, size_t minPerThread) {
+    size_t byWork = std::max<size_t>(count / std::max<size_t>(minPerThread, 1), 1);
+    size_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+    return static_cast<unsigned>(std::min(byWork, hardware));
+}
+
+// Разбить [0, count) на непрерывные части по числу потоков;
+// body(begin, end) вызывается для каждой части
+template<typename Body>
+void parallelFor(size_t count, unsigned threads, Body body) {
+    threads = static_cast<unsigned>(std::min<size_t>(std::max(threads, 1u), count));
+    if (threads <= 1) {
+        body(0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        workers.emplace_back(body, begin, std::min(begin + chunk, count));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
@@ -0,0 +1,224 @@
+#pragma once
+#include "bdd_manager.h"
+#include "parallel.h"
+#include <atomic>
+#include <mutex>
+
+// Менеджер БДР с многопоточным apply.
+// Верхние уровни рекурсии apply раскрываются заранее в дерево подзадач
+// по кофакторам (до TASKS_PER_THREAD задач на поток). Потоки разбирают
+// листья дерева из общей очереди с атомарным счётчиком: освободившийся
+// поток берёт следующую задачу, так что неравные по объёму кофакторы
+// уравновешиваются. Каждая задача - обычная рекурсия apply, но узлы
+// создаются в общей уникальной таблице под блокировкой одной из
+// LOCK_STRIPES полос (полоса выбирается по цепочке), а кеш вычислений у
+// каждого потока свой. Место под новые узлы резервируется заранее, массив
+// узлов во время параллельной фазы не перемещается; счётчики ссылок и
+// размеры уровней досчитываются после неё. Если резерва не хватило, новые
+// узлы откатываются и фаза повторяется с вдвое большим резервом.
+// Дерево подзадач собирается обычным mk в вызывающем потоке.
+class ParallelBDDManager : public BDDManager {
+private:
+    static constexpr size_t LOCK_STRIPES = 1024;
+    static constexpr size_t WORKER_CACHE_SIZE = 1 << 16;
+    static constexpr unsigned TASKS_PER_THREAD = 8;
+    static constexpr size_t MIN_RESERVE = 1 << 20;
+
+    struct Overflow {};
+
+    std::vector<std::mutex> stripes;
+    std::atomic<uint32_t> nextNode{0};
+    uint32_t capacity = 0;
+
+    // Узел дерева подзадач: либо лист (задача для потока), либо
+    // разложение по переменной var на две подзадачи
+    struct Task {
+        uint32_t f, g;
+        int var = -1;
+        int low = -1, high = -1;
+        uint32_t result = NO_NODE;
+    };
+
+    uint32_t mkConcurrent(int var, uint32_t low, uint32_t high) {
+        if (low == high) {
+            return low;
+        }
+
+        size_t index = bucketIndex(var, low, high);
+        std::lock_guard<std::mutex> lock(stripes[hash3(static_cast<uint64_t>(var), index, 0) % LOCK_STRIPES]);
+        uint32_t& head = buckets[var][index];
+        for (uint32_t f = head; f != NO_NODE; f = nodes[f].next) {
+            if (nodes[f].low == low && nodes[f].high == high) {
+                return f;
+            }
+        }
+
+        uint32_t f = nextNode.fetch_add(1);
+        if (f >= capacity) {
+            throw Overflow{};
+        }
+        nodes[f] = {var, low, high, head};
+        head = f;
+        return f;
+    }
+
+    // Рекурсия apply одного потока со своим кешем
+    class Worker {
+    private:
+        ParallelBDDManager& manager;
+        std::vector<CacheEntry> cache;
+
+        CacheEntry& entry(uint32_t op, uint32_t a, uint32_t b) {
+            return cache[hash3(a ^ (uint64_t(op) << 32), b, 0) & (cache.size() - 1)];
+        }
+
+    public:
+        explicit Worker(ParallelBDDManager& m)
+            : manager(m), cache(WORKER_CACHE_SIZE, CacheEntry{OP_NONE, 0, 0, 0, 0}) {}
+
+        uint32_t negate(uint32_t f) {
+            if (manager.isTerminal(f)) {
+                return f ^ 1;
+            }
+            CacheEntry& cached = entry(OP_NOT, f, 0);
+            if (cached.op == OP_NOT && cached.a == f) {
+                return cached.result;
+            }
+
+            const BDDNode& node = manager.nodes[f];
+            int var = node.varIndex;
+            uint32_t fLow = node.low, fHigh = node.high;
+            uint32_t result = manager.mkConcurrent(var, negate(fLow), negate(fHigh));
+
+            entry(OP_NOT, f, 0) = {OP_NOT, f, 0, 0, result};
+            return result;
+        }
+
+        uint32_t apply(BDDOp op, uint32_t f, uint32_t g) {
+            uint32_t result = applyTerminal(op, f, g, [this](uint32_t x) { return negate(x); });
+            if (result != NO_NODE) {
+                return result;
+            }
+            if (isCommutative(op) && f > g) {
+                std::swap(f, g);
+            }
+
+            uint32_t code = OP_APPLY + static_cast<uint32_t>(op);
+            CacheEntry& cached = entry(code, f, g);
+            if (cached.op == code && cached.a == f && cached.b == g) {
+                return cached.result;
+            }
+
+            int lvl = std::min(manager.level(f), manager.level(g));
+            int var = manager.level2var[lvl];
+            uint32_t low = apply(op, manager.cofactor(f, lvl, false), manager.cofactor(g, lvl, false));
+            uint32_t high = apply(op, manager.cofactor(f, lvl, true), manager.cofactor(g, lvl, true));
+            result = manager.mkConcurrent(var, low, high);
+
+            entry(code, f, g) = {code, f, g, 0, result};
+            return result;
+        }
+    };
+
+    // Разложение apply(op, f, g) по кофакторам на глубину depth
+    int split(std::vector<Task>& tasks, uint32_t f, uint32_t g, int depth) {
+        int index = static_cast<int>(tasks.size());
+        tasks.push_back({f, g});
+        if (depth == 0 || isTerminal(f) || isTerminal(g) || f == g) {
+            return index;
+        }
+
+        int lvl = std::min(level(f), level(g));
+        int low = split(tasks, cofactor(f, lvl, false), cofactor(g, lvl, false), depth - 1);
+        int high = split(tasks, cofactor(f, lvl, true), cofactor(g, lvl, true), depth - 1);
+        tasks[index].var = level2var[lvl];
+        tasks[index].low = low;
+        tasks[index].high = high;
+        return index;
+    }
+
+    // Параллельная фаза над листьями дерева; false, если не хватило резерва
+    bool runLeaves(BDDOp op, std::vector<Task>& tasks, const std::vector<int>& leaves,
+                   unsigned threads, size_t reserve) {
+        uint32_t start = static_cast<uint32_t>(nodes.size());
+        capacity = static_cast<uint32_t>(std::min<size_t>(start + reserve, NO_NODE));
+        nextNode = start;
+        nodes.resize(capacity);
+
+        std::atomic<size_t> nextLeaf{0};
+        std::atomic<bool> overflow{false};
+        parallelFor(threads, threads, [&](size_t, size_t) {
+            Worker worker(*this);
+            try {
+                for (size_t k = nextLeaf++; k < leaves.size() && !overflow; k = nextLeaf++) {
+                    Task& task = tasks[leaves[k]];
+                    task.result = worker.apply(op, task.f, task.g);
+                }
+            } catch (const Overflow&) {
+                overflow = true;
+            }
+        });
+
+        uint32_t used = std::min(nextNode.load(), capacity);
+        if (overflow) {
+            // новые узлы стоят в начале цепочек, перед всеми старыми
+            for (std::vector<uint32_t>& table : buckets) {
+                for (uint32_t& head : table) {
+                    while (head != NO_NODE && head >= start) head = nodes[head].next;
+                }
+            }
+            nodes.resize(start);
+            return false;
+        }
+
+        nodes.resize(used);
+        refs.resize(used, 0);
+        for (uint32_t f = start; f < used; ++f) {
+            ++refs[nodes[f].low];
+            ++refs[nodes[f].high];
+            ++levelCounts[nodes[f].varIndex];
+        }
+        for (int var = 0; var < numVars; ++var) {
+            while (levelCounts[var] > buckets[var].size()) growBuckets(var);
+        }
+        growCacheIfNeeded();
+        return true;
+    }
+
+public:
+    explicit ParallelBDDManager(int n) : BDDManager(n), stripes(LOCK_STRIPES) {}
+
+    // apply(op, f, g) в threads потоках; при threads <= 1 - обычный apply
+    uint32_t parallelApply(BDDOp op, uint32_t f, uint32_t g, unsigned threads) {
+        if (threads <= 1) {
+            return apply(op, f, g);
+        }
+
+        int depth = 0;
+        while ((1u << depth) < threads * TASKS_PER_THREAD) ++depth;
+
+        std::vector<Task> tasks;
+        split(tasks, f, g, depth);
+        std::vector<int> leaves;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            if (tasks[i].var < 0) leaves.push_back(static_cast<int>(i));
+        }
+
+        size_t reserve = std::max(MIN_RESERVE, 4 * (countNodes(f) + countNodes(g)));
+        while (!runLeaves(op, tasks, leaves, threads, reserve)) {
+            if (nodes.size() + reserve >= NO_NODE) {
+                throw std::length_error("Превышено максимальное число узлов БДР");
+            }
+            reserve *= 2;
+        }
+
+        // потомки в дереве идут после родителя
+        for (size_t i = tasks.size(); i-- > 0;) {
+            Task& task = tasks[i];
+            if (task.var >= 0) {
+                task.result = mk(task.var, tasks[task.low].result, tasks[task.high].result);
+            }
+        }
+        return tasks[0].result;
+    }
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include "zhegalkin.h"
+#include <chrono>
+
+// Итог анализа функции: принадлежность пяти замкнутым классам Поста,
+// существенные переменные и классы попарно симметричных переменных
+struct FunctionProperties {
+    bool preservesZero = false;  // T0: f(0, ..., 0) = 0
+    bool preservesOne = false;   // T1: f(1, ..., 1) = 1
+    bool selfDual = false;       // S:  f(¬x) = ¬f(x)
+    bool monotone = false;       // M
+    bool linear = false;         // L:  степень полинома Жегалкина <= 1
+    int degree = -1;             // -1 для тождественного нуля
+
+    std::vector<int> essential;
+    // симметрия по паре - отношение эквивалентности, поэтому хранятся
+    // классы; пара симметрична, если обе переменные в одном классе
+    std::vector<std::vector<int>> symmetryClasses;
+    double timeMs = 0.0;
+
+    bool symmetric() const { return symmetryClasses.size() <= 1; }
+};
+
+// Анализ по упакованной таблице истинности и мономам полинома Жегалкина.
+// Все проверки идут по словам таблицы без построения кофакторов:
+// монотонность и существенность - сравнение половин по каждой переменной,
+// самодвойственность - сравнение с зеркально отражённой инвертированной
+// таблицей, симметрия - сдвиг на 2^p - 2^q строк.
+class PropertyAnalyzer : public CliUI {
+private:
+    static void printVars(const std::vector<int>& vars) {
+        for (size_t i = 0; i < vars.size(); ++i) {
+            if (i > 0) std::cout << ", ";
+            std::cout << "x" << (vars[i] + 1);
+        }
+    }
+
+public:
+    static FunctionProperties analyze(const BitTable& table, const std::vector<uint64_t>& monomials) {
+        auto start = std::chrono::steady_clock::now();
+        FunctionProperties result;
+        int n = table.getNumVars();
+
+        result.preservesZero = table.get(0) == 0;
+        result.preservesOne = table.get(table.rows() - 1) == 1;
+        result.selfDual = table.isSelfDual();
+
+        for (uint64_t mask : monomials) {
+            result.degree = std::max(result.degree, __builtin_popcountll(mask));
+        }
+        result.linear = result.degree <= 1;
+
+        result.monotone = true;
+        for (int var = 0; var < n; ++var) {
+            if (result.monotone && !table.monotoneIn(var)) result.monotone = false;
+            if (table.dependsOn(var)) result.essential.push_back(var);
+        }
+
+        for (int var = 0; var < n; ++var) {
+            bool placed = false;
+            for (std::vector<int>& group : result.symmetryClasses) {
+                if (table.symmetricIn(group[0], var)) {
+                    group.push_back(var);
+                    placed = true;
+                    break;
+                }
+            }
+            if (!placed) result.symmetryClasses.push_back({var});
+        }
+
+        result.timeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    void displayProperties(const ZhegalkinPolynomial& f) {
+        printHeader("СВОЙСТВА ФУНКЦИИ");
+
+        FunctionProperties p = analyze(f.getTable(), f.getMonomials());
+        auto mark = [](bool value) { return value ? "да" : "нет"; };
+
+        std::cout << "Сохраняет 0 (T0):      " << mark(p.preservesZero) << "\n";
+        std::cout << "Сохраняет 1 (T1):      " << mark(p.preservesOne) << "\n";
+        std::cout << "Самодвойственна (S):   " << mark(p.selfDual) << "\n";
+        std::cout << "Монотонна (M):         " << mark(p.monotone) << "\n";
+        std::cout << "Линейна (L):           " << mark(p.linear)
+                  << " (степень полинома " << p.degree << ")\n";
+        if (!p.preservesZero && !p.preservesOne && !p.selfDual && !p.monotone && !p.linear) {
+            std::cout << "Функция не лежит ни в одном классе Поста - сама образует полную систему\n";
+        }
+        printSeparator();
+
+        std::cout << "Существенные переменные (" << p.essential.size() << "): ";
+        printVars(p.essential);
+        std::cout << "\n";
+
+        std::cout << "Симметрична по всем переменным: " << mark(p.symmetric()) << "\n";
+        std::cout << "Классы симметричных переменных:\n";
+        for (const std::vector<int>& group : p.symmetryClasses) {
+            if (group.size() < 2) continue;
+            std::cout << "  {";
+            printVars(group);
+            std::cout << "}\n";
+        }
+
+        std::cout << "Время анализа: " << std::fixed << std::setprecision(3) << p.timeMs << " мс\n";
+    }
+};
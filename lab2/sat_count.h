@@ -0,0 +1,143 @@
+#pragma once
+#include "bdd_manager.h"
+#include "minimizer.h"
+#include "big_uint.h"
+#include <unordered_map>
+
+// Подсчёт выполняющих наборов (#SAT) и равномерная выборка из них.
+// При создании снимается копия БДР корня: узлы в порядке обхода по
+// уровням (BDDManager::levelOrder), номера 0 и 1 - листья, так что снимок
+// не зависит от последующих перестановок и сборки мусора в менеджере.
+// Для узла уровня L хранится число выполняющих наборов переменных уровней
+// L..n-1; потомки лежат дальше по массиву, поэтому все числа считаются
+// одним проходом с конца, за время, линейное по числу узлов. Ребро через
+// k пропущенных уровней умножает число на 2^k. Подсчёт работает при любом
+// n; выборка и перечисление кубов выдают 64-битные маски и требуют n <= 64.
+class SatCounter {
+private:
+    static constexpr uint32_t FIRST_NODE = 2;
+
+    int numVars;
+    uint32_t root;
+    std::vector<int> vars;        // переменная узла, у листьев -1
+    std::vector<int> levels;      // уровень узла, у листьев - n
+    std::vector<uint32_t> edges;  // по два на узел, включая листья
+    std::vector<BigUInt> counts;  // по узлам, включая листья
+
+    // Вклад ребра в узел child из узла уровня level
+    BigUInt edgeCount(uint32_t child, int level) const {
+        return counts[child] << static_cast<size_t>(levels[child] - level - 1);
+    }
+
+public:
+    SatCounter(const BDDManager& manager, uint32_t f) : numVars(manager.getNumVars()) {
+        std::vector<uint32_t> order = manager.levelOrder({f});
+        size_t size = order.size() + FIRST_NODE;
+
+        std::unordered_map<uint32_t, uint32_t> index;
+        index[BDDManager::FALSE_NODE] = 0;
+        index[BDDManager::TRUE_NODE] = 1;
+        for (size_t i = 0; i < order.size(); ++i) {
+            index[order[i]] = static_cast<uint32_t>(i + FIRST_NODE);
+        }
+        root = index[f];
+
+        vars.assign(size, -1);
+        levels.assign(size, numVars);
+        edges = {0, 0, 1, 1};
+        edges.reserve(2 * size);
+        for (size_t i = 0; i < order.size(); ++i) {
+            const BDDNode& node = manager.node(order[i]);
+            vars[i + FIRST_NODE] = node.varIndex;
+            levels[i + FIRST_NODE] = manager.level(order[i]);
+            edges.push_back(index[node.low]);
+            edges.push_back(index[node.high]);
+        }
+
+        counts.assign(size, BigUInt());
+        counts[1] = 1;
+        for (size_t i = size; i-- > FIRST_NODE;) {
+            counts[i] = edgeCount(edges[2 * i], levels[i]) + edgeCount(edges[2 * i + 1], levels[i]);
+        }
+    }
+
+    int getNumVars() const { return numVars; }
+
+    // Узлы снимка: корень, потомки и переменная; 0 и 1 - листья
+    uint32_t getRoot() const { return root; }
+    uint32_t low(uint32_t i) const { return edges[2 * i]; }
+    uint32_t high(uint32_t i) const { return edges[2 * i + 1]; }
+    int var(uint32_t i) const { return vars[i]; }
+
+    // Число выполняющих наборов всех n переменных
+    BigUInt count() const {
+        return edgeCount(root, -1);
+    }
+
+    // Равномерно случайный выполняющий набор (упакованный, старший бит -
+    // x1): спуск от корня, где ветвь выбирается с вероятностью,
+    // пропорциональной числу её наборов; пропущенные переменные случайны
+    template<typename Rng>
+    uint64_t sample(Rng& rng) const {
+        if (numVars > 64) {
+            throw std::invalid_argument("Набор задаётся маской не более чем для 64 переменных");
+        }
+        if (root == 0) {
+            throw std::domain_error("Функция невыполнима");
+        }
+
+        uint64_t input = numVars == 0 ? 0 : rng() & (~0ULL >> (64 - numVars));
+        uint32_t i = root;
+        while (i >= FIRST_NODE) {
+            uint64_t bit = 1ULL << (numVars - 1 - vars[i]);
+            BigUInt choice = BigUInt::randomBelow(counts[i], rng);
+            if (choice < edgeCount(low(i), levels[i])) {
+                input &= ~bit;
+                i = low(i);
+            } else {
+                input |= bit;
+                i = high(i);
+            }
+        }
+        return input;
+    }
+};
+
+// Ленивый перечислитель путей БДР в лист 1 (по снимку SatCounter, n <= 64):
+// каждый путь - куб (см. Cube), кубы попарно не пересекаются и вместе
+// покрывают все единицы функции. Обход в глубину с явным стеком, next
+// выдаёт следующий куб за время, пропорциональное длине пути, не строя
+// список заранее.
+class CubeEnumerator {
+private:
+    const SatCounter& bdd;
+    std::vector<std::pair<uint32_t, Cube>> stack;
+
+public:
+    explicit CubeEnumerator(const SatCounter& counter) : bdd(counter) {
+        if (bdd.getNumVars() > 64) {
+            throw std::invalid_argument("Куб задаётся маской не более чем для 64 переменных");
+        }
+        stack.push_back({bdd.getRoot(), Cube{}});
+    }
+
+    bool next(Cube& cube) {
+        int n = bdd.getNumVars();
+        while (!stack.empty()) {
+            uint32_t i = stack.back().first;
+            Cube current = stack.back().second;
+            stack.pop_back();
+
+            if (i == 1) {
+                cube = current;
+                return true;
+            }
+            if (i == 0) continue;
+
+            uint64_t bit = 1ULL << (n - 1 - bdd.var(i));
+            stack.push_back({bdd.high(i), Cube{current.value | bit, current.care | bit}});
+            stack.push_back({bdd.low(i), Cube{current.value, current.care | bit}});
+        }
+        return false;
+    }
+};
@@ -1,4 +1,10 @@
+#pragma once
 #include "cli_ui.h"
+#include "bit_table.h"
+#include "parallel.h"
+#include "minimizer.h"
+#include "walsh.h"
+#include <memory>
 #include <vector>
 #include <string>
 #include <iomanip>
@@ -6,7 +12,35 @@
 class TruthTable : public CliUI {
 protected:
     int numVars;
-    std::vector<int> values;
+    BitTable table;
+
+    // слов результата (по 64 набора) на поток при пакетном вычислении
+    static constexpr size_t BATCH_WORDS_PER_THREAD = 1024;
+    // коэффициентов спектра на поток
+    static constexpr size_t WALSH_PER_THREAD = 1 << 16;
+
+    // спектр Уолша-Адамара строится при первом обращении; таблица не
+    // меняется, поэтому копии функции могут делить один спектр
+    mutable std::shared_ptr<const WalshSpectrum> walsh;
+
+    // Общая схема пакетного вычисления: наборы делятся на группы по 64,
+    // evalWord(group, count) возвращает слово результатов группы, группы
+    // распределяются между потоками непрерывными частями
+    template<typename EvalWord>
+    static std::vector<uint64_t> evaluateWords(const std::vector<uint64_t>& inputs, EvalWord evalWord) {
+        size_t numWords = (inputs.size() + 63) / 64;
+        std::vector<uint64_t> results(numWords, 0);
+
+        unsigned threads = chooseThreads(numWords, BATCH_WORDS_PER_THREAD);
+        parallelFor(numWords, threads, [&](size_t begin, size_t end) {
+            for (size_t w = begin; w < end; ++w) {
+                size_t first = w * 64;
+                size_t count = std::min<size_t>(64, inputs.size() - first);
+                results[w] = evalWord(inputs.data() + first, count);
+            }
+        });
+        return results;
+    }
 
     void printTruthTable() const {
         std::cout << "| № |";
@@ -27,12 +61,28 @@ protected:
             for (int j = numVars - 1; j >= 0; --j) {
                 std::cout << "  " << ((i >> j) & 1) << " |";
             }
-            std::cout << " " << values[i] << " |\n";
+            std::cout << " " << table.get(i) << " |\n";
         }
     }
 
+    void printMinimalForm(const MinimalForm& form, bool cnf) const {
+        std::cout << "f = ";
+        NormalFormWriter writer(std::cout, numVars, cnf);
+        for (const Cube& cube : form.cubes) {
+            writer.term(cube);
+        }
+        writer.finish();
+
+        std::cout << "\n\n" << (cnf ? "Дизъюнктов: " : "Конъюнкций: ") << form.cubes.size()
+                  << ", литералов: " << form.literals() << "\n";
+        std::cout << (form.exact ? "Форма минимальна" : "Форма близка к минимальной (эвристика)") << "\n";
+    }
+
 public:
-    TruthTable(int n, const std::vector<int>& vals) : numVars(n), values(vals) {}
+    TruthTable(int n, const std::vector<int>& vals)
+        : numVars(n), table(BitTable::fromValues(n, vals)) {}
+
+    explicit TruthTable(const BitTable& t) : numVars(t.getNumVars()), table(t) {}
 
     void displayTable() {
         printHeader("ТАБЛИЦА ИСТИННОСТИ");
@@ -41,64 +91,110 @@ public:
 
     void displaySDNF() {
         printHeader("СДНФ");
-        std::string sdnf;
-        bool first = true;
-        int numRows = 1 << numVars;
-
-        for (int i = 0; i < numRows; ++i) {
-            if (values[i] == 1) {
-                if (!first) sdnf += " ∨ ";
-                first = false;
+        std::cout << "f = ";
 
-                std::string term;
-                for (int j = numVars - 1; j >= 0; --j) {
-                    if (!term.empty()) term += "∧";
-                    if ((i >> j) & 1) {
-                        term += "x" + std::to_string(numVars - j);
-                    } else {
-                        term += "¬x" + std::to_string(numVars - j);
-                    }
-                }
-                sdnf += "(" + term + ")";
-            }
+        NormalFormWriter writer(std::cout, numVars, false);
+        uint64_t full = table.rows() - 1;
+        for (size_t i = 0; i < table.rows(); ++i) {
+            if (table.get(i) == 1) writer.term({i, full});
         }
-        std::cout << "f = " << (sdnf.empty() ? "0" : sdnf) << "\n";
+        writer.finish();
+        std::cout << "\n";
     }
 
     void displaySKNF() {
         printHeader("СКНФ");
-        std::string sknf;
-        bool first = true;
-        int numRows = 1 << numVars;
+        std::cout << "f = ";
 
-        for (int i = 0; i < numRows; ++i) {
-            if (values[i] == 0) {
-                if (!first) sknf += " ∧ ";
-                first = false;
+        NormalFormWriter writer(std::cout, numVars, true);
+        uint64_t full = table.rows() - 1;
+        for (size_t i = 0; i < table.rows(); ++i) {
+            if (table.get(i) == 0) writer.term({i, full});
+        }
+        writer.finish();
+        std::cout << "\n";
+    }
 
-                std::string clause;
+    void displayMinimalDNF() {
+        printHeader("МИНИМАЛЬНАЯ ДНФ");
+        printMinimalForm(Minimizer::minimizeDNF(table), false);
+    }
+
+    void displayMinimalCNF() {
+        printHeader("МИНИМАЛЬНАЯ КНФ");
+        printMinimalForm(Minimizer::minimizeCNF(table), true);
+    }
+
+    const WalshSpectrum& getWalshSpectrum() const {
+        if (!walsh) {
+            walsh = std::make_shared<const WalshSpectrum>(table, chooseThreads(table.rows(), WALSH_PER_THREAD));
+        }
+        return *walsh;
+    }
+
+    void displayWalshSpectrum() {
+        printHeader("СПЕКТР УОЛША-АДАМАРА");
+
+        if (numVars > WalshSpectrum::MAX_VARS) {
+            std::cout << "Спектр строится не более чем для " << WalshSpectrum::MAX_VARS << " переменных\n";
+            return;
+        }
+        const WalshSpectrum& spectrum = getWalshSpectrum();
+
+        if (numVars <= 6) {
+            const std::vector<int32_t>& w = spectrum.getCoefficients();
+            for (size_t a = 0; a < w.size(); ++a) {
+                std::cout << "  W(";
                 for (int j = numVars - 1; j >= 0; --j) {
-                    if (!clause.empty()) clause += "∨";
-                    if ((i >> j) & 1) {
-                        clause += "¬x" + std::to_string(numVars - j);
-                    } else {
-                        clause += "x" + std::to_string(numVars - j);
-                    }
+                    std::cout << ((a >> j) & 1);
                 }
-                sknf += "(" + clause + ")";
+                std::cout << ") = " << std::setw(3) << w[a] << "\n";
             }
+            printSeparator();
+        }
+
+        std::cout << "max |W(a)|: " << spectrum.maxAbsolute() << "\n";
+        std::cout << "Нелинейность: " << spectrum.nonlinearity() << "\n";
+        std::cout << "Уравновешенна: " << (spectrum.balanced() ? "да" : "нет") << "\n";
+        std::cout << "Порядок корреляционной иммунности: " << spectrum.correlationImmunity() << "\n";
+        if (spectrum.resiliency() >= 0) {
+            std::cout << "Устойчивость порядка " << spectrum.resiliency() << "\n";
+        } else {
+            std::cout << "Не устойчива (не уравновешенна)\n";
+        }
+        if (spectrum.isBent()) {
+            std::cout << "Бент-функция (максимальная нелинейность)\n";
         }
-        std::cout << "f = " << (sknf.empty() ? "1" : sknf) << "\n";
     }
 
-    int evaluate(const std::vector<int>& input) const {
-        int index = 0;
+    // Номер строки набора: x1 - старший бит
+    uint64_t packInput(const std::vector<int>& input) const {
+        uint64_t index = 0;
         for (int i = 0; i < numVars; ++i) {
-            index = (index << 1) | input[i];
+            index = (index << 1) | (input[i] ? 1 : 0);
         }
-        return values[index];
+        return index;
+    }
+
+    int evaluate(const std::vector<int>& input) const {
+        return table.get(packInput(input));
+    }
+
+    // Пакетное вычисление на упакованных наборах (см. packInput): бит k % 64
+    // слова k / 64 результата - значение f на inputs[k]. Биты наборов выше
+    // n-го не учитываются.
+    std::vector<uint64_t> evaluateBatch(const std::vector<uint64_t>& inputs) const {
+        uint64_t rowMask = table.rows() - 1;
+        return evaluateWords(inputs, [this, rowMask](const uint64_t* group, size_t count) {
+            uint64_t word = 0;
+            for (size_t k = 0; k < count; ++k) {
+                word |= uint64_t(table.get(group[k] & rowMask)) << k;
+            }
+            return word;
+        });
     }
 
     int getNumVars() const { return numVars; }
-    const std::vector<int>& getValues() const { return values; }
+    std::vector<int> getValues() const { return table.toValues(); }
+    const BitTable& getTable() const { return table; }
 };
@@ -0,0 +1,200 @@
+#pragma once
+#include "bit_table.h"
+#include "parallel.h"
+#include <cstring>
+
+// Спектр Уолша-Адамара W(a) = сумма по x от (-1)^(f(x) ⊕ a·x).
+// Индекс a нумеруется как строки таблицы: бит (n - 1 - j) - x(j+1).
+// Быстрое преобразование на месте за n·2^n сложений. Три первых уровня
+// берутся из таблицы спектров байтов таблицы истинности, затем все уровни
+// внутри блоков по 2^BLOCK_BITS коэффициентов (блок помещается в кеш,
+// блоки независимы), затем уровни с шагом от размера блока, где четвёрки
+// режутся на непрерывные отрезки по первому элементу. Уровни идут парами
+// (радикс 4), чтобы вдвое сократить проходы по памяти; бабочки считаются
+// векторами по четыре коэффициента, отрезки распределяются между потоками.
+class WalshSpectrum {
+private:
+    static constexpr int BLOCK_BITS = 14;
+
+    int numVars;
+    std::vector<int32_t> coefficients;
+    int32_t maxAbs = 0;
+    int immunity = 0;
+
+    // Четыре коэффициента в одном векторном регистре (расширение GCC/Clang,
+    // на x86-64 - SSE2 без дополнительных флагов компиляции)
+    typedef int32_t Lanes __attribute__((vector_size(16)));
+    static constexpr size_t LANES = sizeof(Lanes) / sizeof(int32_t);
+
+    static Lanes load(const int32_t* p) {
+        Lanes x;
+        std::memcpy(&x, p, sizeof(Lanes));
+        return x;
+    }
+
+    static void store(int32_t* p, Lanes x) {
+        std::memcpy(p, &x, sizeof(Lanes));
+    }
+
+    // Один уровень: пары (p[j], p[h + j]) для j < count
+    static void butterflies(int32_t* p, size_t h, size_t count) {
+        size_t j = 0;
+        for (; j + LANES <= count; j += LANES) {
+            Lanes a = load(p + j), b = load(p + h + j);
+            store(p + j, a + b);
+            store(p + h + j, a - b);
+        }
+        for (; j < count; ++j) {
+            int32_t a = p[j], b = p[h + j];
+            p[j] = a + b;
+            p[h + j] = a - b;
+        }
+    }
+
+    // Два уровня (h и 2h) за один проход по памяти: четвёрки
+    // (p[j], p[h + j], p[2h + j], p[3h + j]) для j < count
+    static void butterflies4(int32_t* p, size_t h, size_t count) {
+        size_t j = 0;
+        for (; j + LANES <= count; j += LANES) {
+            Lanes a = load(p + j), b = load(p + h + j);
+            Lanes c = load(p + 2 * h + j), d = load(p + 3 * h + j);
+            Lanes s0 = a + b, d0 = a - b, s1 = c + d, d1 = c - d;
+            store(p + j, s0 + s1);
+            store(p + h + j, d0 + d1);
+            store(p + 2 * h + j, s0 - s1);
+            store(p + 3 * h + j, d0 - d1);
+        }
+        for (; j < count; ++j) {
+            int32_t a = p[j], b = p[h + j], c = p[2 * h + j], d = p[3 * h + j];
+            p[j] = a + b + c + d;
+            p[h + j] = a - b + c - d;
+            p[2 * h + j] = a + b - c - d;
+            p[3 * h + j] = a - b - c + d;
+        }
+    }
+
+    static void transformBlock(int32_t* data, size_t length, size_t firstStep) {
+        size_t h = firstStep;
+        for (; 4 * h <= length; h *= 4) {
+            for (size_t i = 0; i < length; i += 4 * h) {
+                butterflies4(data + i, h, h);
+            }
+        }
+        if (h < length) {
+            for (size_t i = 0; i < length; i += 2 * h) {
+                butterflies(data + i, h, h);
+            }
+        }
+    }
+
+    // Спектры всех функций трёх переменных: восемь строк таблицы - байт,
+    // поэтому знаковая форма и три первых уровня заменяются копированием
+    struct ByteSpectra {
+        int32_t values[256][8];
+
+        ByteSpectra() {
+            for (int byte = 0; byte < 256; ++byte) {
+                int32_t* w = values[byte];
+                for (int k = 0; k < 8; ++k) {
+                    w[k] = 1 - 2 * ((byte >> k) & 1);
+                }
+                transformBlock(w, 8, 1);
+            }
+        }
+    };
+
+    // Уровни с шагом от firstStep
+    void transform(unsigned threads, size_t firstStep) {
+        int32_t* data = coefficients.data();
+        size_t size = coefficients.size();
+        size_t block = std::min(size, size_t(1) << BLOCK_BITS);
+
+        parallelFor(size / block, threads, [data, block, firstStep](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                transformBlock(data + k * block, block, firstStep);
+            }
+        });
+
+        size_t h = block;
+        for (; 4 * h <= size; h *= 4) {
+            parallelFor(size / 4 / block, threads, [data, block, h](size_t begin, size_t end) {
+                for (size_t c = begin; c < end; ++c) {
+                    size_t first = c * block;
+                    butterflies4(data + (first / h) * 4 * h + first % h, h, block);
+                }
+            });
+        }
+        if (h < size) {
+            parallelFor(size / 2 / block, threads, [data, block, h](size_t begin, size_t end) {
+                for (size_t c = begin; c < end; ++c) {
+                    size_t first = c * block;
+                    butterflies(data + (first / h) * 2 * h + first % h, h, block);
+                }
+            });
+        }
+    }
+
+public:
+    // |W(a)| <= 2^n должно помещаться в int32_t
+    static constexpr int MAX_VARS = 30;
+
+    explicit WalshSpectrum(const BitTable& table, unsigned threads = 1)
+        : numVars(table.getNumVars()) {
+        if (numVars > MAX_VARS) {
+            throw std::length_error("Спектр Уолша-Адамара строится не более чем для 30 переменных");
+        }
+
+        coefficients.resize(table.rows());
+        const std::vector<uint64_t>& words = table.getWords();
+
+        if (numVars < 3) {
+            for (size_t x = 0; x < coefficients.size(); ++x) {
+                coefficients[x] = 1 - 2 * table.get(x);
+            }
+            transform(1, 1);
+        } else {
+            static const ByteSpectra bytes;
+            parallelFor(coefficients.size() / 8, threads, [this, &words](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) {
+                    uint64_t byte = (words[k / 8] >> (8 * (k % 8))) & 0xFF;
+                    std::copy(bytes.values[byte], bytes.values[byte] + 8, coefficients.data() + 8 * k);
+                }
+            });
+            transform(threads, 8);
+        }
+
+        // порядок корреляционной иммунности: W(a) = 0 для всех a с весом
+        // от 1 до m, то есть m на единицу меньше наименьшего веса a != 0
+        // с ненулевым коэффициентом
+        immunity = numVars;
+        for (size_t a = 0; a < coefficients.size(); ++a) {
+            int32_t value = coefficients[a];
+            maxAbs = std::max(maxAbs, value < 0 ? -value : value);
+            if (a != 0 && value != 0) {
+                immunity = std::min(immunity, __builtin_popcountll(a) - 1);
+            }
+        }
+    }
+
+    int getNumVars() const { return numVars; }
+    const std::vector<int32_t>& getCoefficients() const { return coefficients; }
+    int32_t maxAbsolute() const { return maxAbs; }
+
+    // Расстояние до ближайшей аффинной функции: 2^(n-1) - max|W| / 2
+    uint64_t nonlinearity() const {
+        return ((uint64_t(1) << numVars) - static_cast<uint64_t>(maxAbs)) / 2;
+    }
+
+    bool balanced() const { return coefficients[0] == 0; }
+
+    int correlationImmunity() const { return immunity; }
+
+    // Устойчивость - уравновешенность и корреляционная иммунность порядка m;
+    // -1 для неуравновешенной функции
+    int resiliency() const { return balanced() ? immunity : -1; }
+
+    // Бент-функция: |W(a)| = 2^(n/2) для всех a (по Парсевалю достаточно max)
+    bool isBent() const {
+        return numVars % 2 == 0 && maxAbs == (int32_t(1) << (numVars / 2));
+    }
+};
@@ -0,0 +1,237 @@
+#pragma once
+#include "bdd_manager.h"
+#include "big_uint.h"
+
+// Операции над семействами множеств переменных
+enum class ZDDOp {
+    UNION,      // F ∪ G
+    INTERSECT,  // F ∩ G
+    DIFF,       // F \ G
+    SYMDIFF,    // F ⊕ G - сумма полиномов Жегалкина
+    JOIN,       // {a ∪ b : a ∈ F, b ∈ G}
+    PRODUCT,    // как JOIN, но одинаковые a ∪ b взаимно уничтожаются -
+                // произведение полиномов Жегалкина (x·x = x)
+};
+
+// Менеджер ДРНП (ZDD, диаграмм решений с подавлением нулей) для
+// разреженных семейств множеств, например множества мономов полинома
+// Жегалкина. Узел (x, low, high) обозначает low ∪ {s ∪ {x} : s ∈ high};
+// лист 0 - пустое семейство, лист 1 - семейство {∅}. Узел с high = 0
+// не создаётся, поэтому переменные, не входящие ни в одно множество,
+// места не занимают: семейство из m мономов занимает не более m·n узлов.
+//
+// Хранилище узлов, уникальные таблицы, счётчики ссылок, сборка мусора и
+// кеш вычислений - те же, что у BDDManager; отличается только правило
+// сокращения (mkZero вместо mk). Операции БДР и перестановка переменных
+// к ДРНП неприменимы, поэтому наследование закрытое, порядок переменных
+// всегда x1, ..., xn.
+class ZDDManager : private BDDManager {
+public:
+    static constexpr uint32_t EMPTY = FALSE_NODE;  // пустое семейство
+    static constexpr uint32_t BASE = TRUE_NODE;    // {∅}
+
+private:
+    uint32_t mkZero(int var, uint32_t low, uint32_t high) {
+        if (high == EMPTY) {
+            return low;
+        }
+        return findOrAdd(var, low, high);
+    }
+
+    // Множества семейства без переменной уровня lvl и с ней (без самой переменной)
+    uint32_t subset0(uint32_t f, int lvl) const {
+        return level(f) == lvl ? nodes[f].low : f;
+    }
+
+    uint32_t subset1(uint32_t f, int lvl) const {
+        return level(f) == lvl ? nodes[f].high : EMPTY;
+    }
+
+    static uint32_t applyTerminal(ZDDOp op, uint32_t f, uint32_t g) {
+        switch (op) {
+            case ZDDOp::UNION:
+                if (f == EMPTY || f == g) return g;
+                if (g == EMPTY) return f;
+                break;
+            case ZDDOp::INTERSECT:
+                if (f == EMPTY || g == EMPTY) return EMPTY;
+                if (f == g) return f;
+                break;
+            case ZDDOp::DIFF:
+                if (f == EMPTY || f == g) return EMPTY;
+                if (g == EMPTY) return f;
+                break;
+            case ZDDOp::SYMDIFF:
+                if (f == g) return EMPTY;
+                if (f == EMPTY) return g;
+                if (g == EMPTY) return f;
+                break;
+            case ZDDOp::JOIN:
+            case ZDDOp::PRODUCT:
+                if (f == EMPTY || g == EMPTY) return EMPTY;
+                if (f == BASE) return g;
+                if (g == BASE) return f;
+                break;
+        }
+        return NO_NODE;
+    }
+
+    // Маски [begin, end) упорядочены по возрастанию и совпадают в битах
+    // уровней выше lvl; старший бит маски - x1, то есть уровень 0
+    uint32_t buildFromMonomials(const uint64_t* begin, const uint64_t* end, int lvl) {
+        if (begin == end) return EMPTY;
+        if (lvl == numVars) return BASE;
+
+        uint64_t bit = 1ULL << (numVars - 1 - lvl);
+        const uint64_t* middle = std::partition_point(begin, end, [bit](uint64_t mask) {
+            return (mask & bit) == 0;
+        });
+        uint32_t low = buildFromMonomials(begin, middle, lvl + 1);
+        uint32_t high = buildFromMonomials(middle, end, lvl + 1);
+        return mkZero(level2var[lvl], low, high);
+    }
+
+    void checkMaskWidth() const {
+        if (numVars > 64) {
+            throw std::invalid_argument("Маски мономов задаются не более чем для 64 переменных");
+        }
+    }
+
+public:
+    explicit ZDDManager(int n) : BDDManager(n) {}
+
+    using BDDManager::getNumVars;
+    using BDDManager::isTerminal;
+    using BDDManager::node;
+    using BDDManager::addRef;
+    using BDDManager::release;
+    using BDDManager::collectGarbage;
+    using BDDManager::liveNodes;
+    using BDDManager::countNodes;
+    using BDDManager::levelOrder;
+    using BDDManager::getCacheLookups;
+    using BDDManager::getCacheHits;
+
+    // {{x_var}}
+    uint32_t single(int var) {
+        if (var < 0 || var >= numVars) {
+            throw std::out_of_range("Номер переменной вне диапазона");
+        }
+        return mkZero(var, EMPTY, BASE);
+    }
+
+    uint32_t apply(ZDDOp op, uint32_t f, uint32_t g) {
+        uint32_t result = applyTerminal(op, f, g);
+        if (result != NO_NODE) {
+            return result;
+        }
+        if (op != ZDDOp::DIFF && f > g) {
+            std::swap(f, g);
+        }
+
+        uint32_t code = OP_ZDD + static_cast<uint32_t>(op);
+        if (cacheLookup(code, f, g, 0, result)) {
+            return result;
+        }
+
+        int lvl = std::min(level(f), level(g));
+        uint32_t f0 = subset0(f, lvl), f1 = subset1(f, lvl);
+        uint32_t g0 = subset0(g, lvl), g1 = subset1(g, lvl);
+
+        uint32_t low, high;
+        if (op == ZDDOp::JOIN || op == ZDDOp::PRODUCT) {
+            // (F0 ∪ xF1)(G0 ∪ xG1) = F0G0 ∪ x(F0G1 ∪ F1G0 ∪ F1G1)
+            ZDDOp sum = op == ZDDOp::JOIN ? ZDDOp::UNION : ZDDOp::SYMDIFF;
+            low = apply(op, f0, g0);
+            uint32_t cross = apply(sum, apply(op, f0, g1), apply(op, f1, g0));
+            high = apply(sum, cross, apply(op, f1, g1));
+        } else {
+            low = apply(op, f0, g0);
+            high = apply(op, f1, g1);
+        }
+        result = mkZero(level2var[lvl], low, high);
+
+        cacheInsert(code, f, g, 0, result);
+        return result;
+    }
+
+    // Семейство мономов по маскам (старший бит - x1) за O(m·n)
+    uint32_t fromMonomials(std::vector<uint64_t> masks) {
+        checkMaskWidth();
+        std::sort(masks.begin(), masks.end());
+        masks.erase(std::unique(masks.begin(), masks.end()), masks.end());
+        return buildFromMonomials(masks.data(), masks.data() + masks.size(), 0);
+    }
+
+    // Семейство мономов с единичными коэффициентами полинома Жегалкина
+    // (см. ZhegalkinPolynomial::getCoefficients): один проход по словам
+    // вектора коэффициентов, затем fromMonomials
+    uint32_t fromCoefficients(const BitTable& coefficients) {
+        if (coefficients.getNumVars() != numVars) {
+            throw std::invalid_argument("Размер вектора коэффициентов не равен 2^n");
+        }
+        std::vector<uint64_t> masks;
+        const std::vector<uint64_t>& words = coefficients.getWords();
+        for (size_t i = 0; i < words.size(); ++i) {
+            for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+                masks.push_back((uint64_t(i) << 6) | __builtin_ctzll(w));
+            }
+        }
+        return buildFromMonomials(masks.data(), masks.data() + masks.size(), 0);
+    }
+
+    // Маски всех множеств семейства по возрастанию
+    std::vector<uint64_t> toMonomials(uint32_t f) const {
+        checkMaskWidth();
+        std::vector<uint64_t> masks;
+        std::vector<std::pair<uint32_t, uint64_t>> stack = {{f, 0}};
+        while (!stack.empty()) {
+            uint32_t g = stack.back().first;
+            uint64_t mask = stack.back().second;
+            stack.pop_back();
+            if (g == BASE) {
+                masks.push_back(mask);
+            } else if (g != EMPTY) {
+                stack.push_back({nodes[g].low, mask});
+                stack.push_back({nodes[g].high, mask | (1ULL << (numVars - 1 - nodes[g].varIndex))});
+            }
+        }
+        std::sort(masks.begin(), masks.end());
+        return masks;
+    }
+
+    // Число множеств семейства: число путей в лист 1
+    BigUInt count(uint32_t f) const {
+        std::vector<uint32_t> order = levelOrder({f});
+        std::vector<uint32_t> position(nodes.size(), 0);
+        for (size_t i = 0; i < order.size(); ++i) {
+            position[order[i]] = static_cast<uint32_t>(i);
+        }
+
+        std::vector<BigUInt> counts(order.size());
+        auto countOf = [&](uint32_t g) -> BigUInt {
+            if (isTerminal(g)) return BigUInt(g);
+            return counts[position[g]];
+        };
+        // потомки в levelOrder идут после родителя
+        for (size_t i = order.size(); i-- > 0;) {
+            counts[i] = countOf(nodes[order[i]].low) + countOf(nodes[order[i]].high);
+        }
+        return countOf(f);
+    }
+
+    // Значение полинома Жегалкина с мономами f на наборе input (старший
+    // бит - x1): чётность числа мономов, все переменные которых равны 1
+    int evaluate(uint32_t f, uint64_t input) const {
+        checkMaskWidth();
+        std::vector<uint32_t> order = levelOrder({f});
+        std::vector<char> parity(nodes.size(), 0);
+        parity[BASE] = 1;
+        for (size_t i = order.size(); i-- > 0;) {
+            const BDDNode& g = nodes[order[i]];
+            bool set = (input >> (numVars - 1 - g.varIndex)) & 1;
+            parity[order[i]] = parity[g.low] ^ (set ? parity[g.high] : 0);
+        }
+        return parity[f];
+    }
+};
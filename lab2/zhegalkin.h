@@ -1,26 +1,52 @@
+#pragma once
 #include "truth_table.h"
+#include <thread>
 
 class ZhegalkinPolynomial : public TruthTable {
 private:
-    std::vector<int> coefficients;
-
-    void buildCoefficients() {
-        int numRows = 1 << numVars;
-        std::vector<std::vector<int>> triangle(numRows);
-
-        triangle[0] = values;
+    // начиная с этого числа переменных преобразование выполняется в несколько потоков
+    static constexpr int PARALLEL_MOBIUS_MIN_VARS = 22;
+
+    // coefficients.get(i) - коэффициент монома из переменных,
+    // соответствующих единичным битам i (старший бит - x1)
+    BitTable coefficients;
+
+    // Разреженное представление: маски мономов с единичным коэффициентом
+    // по возрастанию, в том же соответствии битов и переменных
+    std::vector<uint64_t> monomials;
+
+    void collectMonomials() {
+        monomials.clear();
+        const std::vector<uint64_t>& words = coefficients.getWords();
+        for (size_t i = 0; i < words.size(); ++i) {
+            for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+                monomials.push_back((uint64_t(i) << 6) | __builtin_ctzll(w));
+            }
+        }
+    }
 
-        for (int i = 1; i < numRows; ++i) {
-            triangle[i].resize(numRows - i);
-            for (int j = 0; j < numRows - i; ++j) {
-                triangle[i][j] = triangle[i-1][j] ^ triangle[i-1][j+1];
+    // Транспонирование битовой матрицы 64x64 на месте:
+    // бит k слова b становится битом b слова k
+    static void transpose64(uint64_t m[64]) {
+        uint64_t mask = 0x00000000FFFFFFFFULL;
+        for (int width = 32; width != 0; width >>= 1, mask ^= mask << width) {
+            for (int k = 0; k < 64; k = (k + width + 1) & ~width) {
+                uint64_t t = ((m[k] >> width) ^ m[k + width]) & mask;
+                m[k] ^= t << width;
+                m[k + width] ^= t;
             }
         }
+    }
 
-        coefficients.resize(numRows);
-        for (int i = 0; i < numRows; ++i) {
-            coefficients[i] = triangle[i][0];
+    void buildCoefficients() {
+        coefficients = table;
+
+        unsigned threads = 1;
+        if (numVars >= PARALLEL_MOBIUS_MIN_VARS) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
         }
+        coefficients.mobiusTransform(threads);
+        collectMonomials();
     }
 
 public:
@@ -28,51 +54,78 @@ public:
         buildCoefficients();
     }
 
+    explicit ZhegalkinPolynomial(const BitTable& t) : TruthTable(t) {
+        buildCoefficients();
+    }
+
+    const BitTable& getCoefficients() const { return coefficients; }
+    const std::vector<uint64_t>& getMonomials() const { return monomials; }
+
     void displayPolynomial() {
         printHeader("ПОЛИНОМ ЖЕГАЛКИНА");
 
         std::string result;
-        int numRows = 1 << numVars;
         bool first = true;
 
-        for (int i = 0; i < numRows; ++i) {
-            if (coefficients[i] == 1) {
-                if (!first) result += " ⊕ ";
-                first = false;
-
-                if (i == 0) {
-                    result += "1";
-                } else {
-                    std::string term;
-                    for (int j = 0; j < numVars; ++j) {
-                        if ((i >> (numVars - 1 - j)) & 1) {
-                            term += "x" + std::to_string(j + 1);
-                        }
+        for (uint64_t mask : monomials) {
+            if (!first) result += " ⊕ ";
+            first = false;
+
+            if (mask == 0) {
+                result += "1";
+            } else {
+                std::string term;
+                for (int j = 0; j < numVars; ++j) {
+                    if ((mask >> (numVars - 1 - j)) & 1) {
+                        term += "x" + std::to_string(j + 1);
                     }
-                    result += term;
                 }
+                result += term;
             }
         }
 
         std::cout << "f = " << (result.empty() ? "0" : result) << "\n";
     }
 
-    int evaluatePolynomial(const std::vector<int>& input) const {
+    // Моном равен 1, если все его переменные входят в набор
+    int evaluatePolynomial(uint64_t input) const {
         int result = 0;
-        int numRows = 1 << numVars;
+        for (uint64_t mask : monomials) {
+            result ^= (mask & ~input) == 0;
+        }
+        return result;
+    }
 
-        for (int i = 0; i < numRows; ++i) {
-            if (coefficients[i] == 1) {
-                int term = 1;
-                for (int j = 0; j < numVars; ++j) {
-                    if ((i >> (numVars - 1 - j)) & 1) {
-                        term &= input[j];
-                    }
-                }
-                result ^= term;
+    int evaluatePolynomial(const std::vector<int>& input) const {
+        return evaluatePolynomial(packInput(input));
+    }
+
+    // Вычисление на count <= 64 наборах сразу (битовые срезы): после
+    // транспонирования слово b содержит значения бита b во всех наборах,
+    // моном вычисляется как AND срезов своих переменных. Бит k результата -
+    // значение f на наборе inputs[k].
+    uint64_t evaluatePolynomial64(const uint64_t* inputs, size_t count) const {
+        uint64_t slices[64] = {};
+        std::copy(inputs, inputs + std::min<size_t>(count, 64), slices);
+        transpose64(slices);
+
+        uint64_t result = 0;
+        for (uint64_t mask : monomials) {
+            uint64_t term = ~0ULL;
+            for (uint64_t m = mask; m != 0; m &= m - 1) {
+                term &= slices[__builtin_ctzll(m)];
             }
+            result ^= term;
         }
-        return result;
+
+        return count >= 64 ? result : result & ((1ULL << count) - 1);
+    }
+
+    // Пакетное вычисление по полиному: по 64 набора за проход битовых срезов
+    std::vector<uint64_t> evaluatePolynomialBatch(const std::vector<uint64_t>& inputs) const {
+        return evaluateWords(inputs, [this](const uint64_t* group, size_t count) {
+            return evaluatePolynomial64(group, count);
+        });
     }
 
     void interactiveEvaluate() {